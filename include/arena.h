@@ -0,0 +1,72 @@
+/*
+ arena.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Arena_H
+#define Fl_Arena_H
+
+#include <stddef.h>
+
+/*
+  Block allocator for many small records thrown away together.
+
+  There is no way to free a single record; clear() hands back every
+  block at once.
+*/
+class Fl_Arena
+{
+
+  public:
+
+    Fl_Arena(
+      size_t const i_block_size = 65536);
+
+    ~Fl_Arena();
+
+    void*
+    allocate(
+      size_t const i_size);
+
+    void
+    clear();
+
+    size_t
+    used() const
+    {
+      return used_;
+    }
+
+  private:
+
+    union align
+    {
+      double d;
+      long l;
+      void* p;
+    };
+
+    struct block
+    {
+      block* next;
+      size_t size;
+      size_t fill;
+      align data[1];
+    };
+
+    block* head_;
+    size_t block_size_;
+    size_t used_;
+
+    Fl_Arena(const Fl_Arena&);
+
+    Fl_Arena&
+    operator=(const Fl_Arena&);
+
+};
+
+#endif
@@ -80,7 +80,7 @@ class Fl_Box : public Fl_Widget
 
   public:
 
-    struct Fl::skin_box skin_;
+    struct Fl::skin_box const* skin_;
 
     Fl_Box(
       int const i_pos_x,
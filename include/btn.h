@@ -138,10 +138,7 @@ class Fl_Button : public Fl_Widget
     }
 
     void
-    shortcut(int const s)
-    {
-      shortcut_ = s;
-    }
+    shortcut(int const s);
 
 };
 
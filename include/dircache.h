@@ -0,0 +1,109 @@
+/*
+ dircache.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Dir_Cache_H
+#define Fl_Dir_Cache_H
+
+#include <time.h>
+#include "dirlist.h"
+
+/*
+  Called once a listing asked for with Fl_Dir_Cache::list() has been
+  read to the end.
+*/
+typedef void (Fl_Dir_Cache_Ready)(
+  Fl_Dir_List* i_list,
+  void* i_data);
+
+/*
+  Listings of the last few directories used, shared by the whole
+  program.
+
+  A listing is kept under the absolute name of its directory until
+  the directory changes.  Where the system driver can watch
+  directories the changes it reports are read whenever the cache is
+  used, one system call for all the listings.  Otherwise the
+  modification time of the directory is checked instead; as FAT does
+  not keep it for directories and NTFS counts it in whole seconds, such
+  a listing is read again when the directory changed around the time
+  it was read, and after AGE seconds in any case.  The least recently used listing makes
+  room for a new one.
+*/
+class Fl_Dir_Cache
+{
+
+  public:
+
+    enum
+    {
+      SLOTS = 8,
+      AGE = 5
+    };
+
+    static Fl_Dir_List*
+    list(
+      char const* i_directory,
+      Fl_Dir_Cache_Ready* i_cb = 0,
+      void* i_data = 0);
+
+    static int
+    isdir(
+      char const* i_path);
+
+    static void
+    cancel(
+      void* i_data);
+
+    static void
+    clear();
+
+  private:
+
+    struct slot
+    {
+      Fl_Dir_List* list;
+      int watch;
+      time_t mtime;
+      time_t listed;
+      bool changed;
+      unsigned long used;
+      Fl_Dir_Cache_Ready* cb;
+      void* data;
+    };
+
+    static slot slots_[SLOTS];
+    static unsigned long used_;
+
+    Fl_Dir_Cache();
+
+    static void
+    update();
+
+    static slot*
+    find(
+      char const* i_directory);
+
+    static bool
+    fresh(
+      slot* io_slot);
+
+    static void
+    release(
+      slot* io_slot);
+
+    static void
+    list_cb(
+      Fl_Dir_List* i_list,
+      char const* const* i_names,
+      int const i_count,
+      void* i_data);
+
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ dirlist.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Dir_List_H
+#define Fl_Dir_List_H
+
+#include <stddef.h>
+#include "arena.h"
+
+class Fl_Dir_List;
+struct Fl_Filename_Pattern;
+
+/*
+  Called by a listing started with Fl_Dir_List::start() after each
+  batch of names, which come in the order they were read.  On the last
+  call, which may have no names, Fl_Dir_List::done() is true.
+*/
+typedef void (Fl_Dir_List_Callback)(
+  Fl_Dir_List* i_list,
+  char const* const* i_names,
+  int const i_count,
+  void* i_data);
+
+typedef int (Fl_Dir_List_Compare)(
+  char const* i_a,
+  char const* i_b);
+
+/*
+  Directory listing read a batch at a time.
+
+  The names are copied into a block arena, so clear() or the
+  destructor gives the whole listing back at once.  They are sorted as
+  they arrive: every name starts a run of its own and the last two
+  runs are merged whenever the newer one is as long as the older, so
+  the listing is in order after O(n log n) compares however it was
+  split up.  "." and ".." are left out, as are names that do not match
+  the pattern given to filter(), which is not copied.
+
+  start() reads the directory from an idle callback, one batch per
+  call, so a large or slow directory does not hold up the event loop.
+*/
+class Fl_Dir_List
+{
+
+  public:
+
+    enum
+    {
+      BATCH = 256
+    };
+
+    Fl_Dir_List();
+
+    ~Fl_Dir_List();
+
+    bool
+    open(
+      char const* i_directory);
+
+    int
+    read();
+
+    void
+    start(
+      Fl_Dir_List_Callback* i_cb,
+      void* i_data = 0);
+
+    void
+    stop();
+
+    void
+    clear();
+
+    void
+    compare(
+      Fl_Dir_List_Compare* i_compare)
+    {
+      compare_ = i_compare;
+    }
+
+    void
+    filter(
+      Fl_Filename_Pattern const* i_pattern)
+    {
+      filter_ = i_pattern;
+    }
+
+    bool
+    done() const
+    {
+      return 0 == dir_;
+    }
+
+    char const*
+    directory() const
+    {
+      return directory_;
+    }
+
+    int
+    count() const
+    {
+      return count_;
+    }
+
+    char const*
+    name(
+      int const i_index);
+
+    int
+    find(
+      char const* i_prefix);
+
+    bool
+    isdir(
+      int const i_index);
+
+  private:
+
+    enum
+    {
+      RUNS_MAX = 64,
+      IDLE_BATCHES = 16
+    };
+
+    enum
+    {
+      TYPE_UNKNOWN,
+      TYPE_FILE,
+      TYPE_DIR
+    };
+
+    void* dir_;
+    char* directory_;
+    Fl_Arena names_;
+    Fl_Dir_List_Compare* compare_;
+    Fl_Filename_Pattern const* filter_;
+
+    Fl_Dir_List_Callback* cb_;
+    void* cb_data_;
+
+    char const** index_;
+    char const** scratch_;
+    int count_;
+    int alloc_;
+
+    int runs_[RUNS_MAX];
+    int nruns_;
+
+    char const* batch_[BATCH];
+
+    Fl_Dir_List(const Fl_Dir_List&);
+
+    Fl_Dir_List&
+    operator=(const Fl_Dir_List&);
+
+    bool
+    push(
+      char const* i_name);
+
+    void
+    merge_top();
+
+    void
+    collapse();
+
+    static void
+    idle_cb(
+      void* i_data);
+
+};
+
+#endif
@@ -92,6 +92,17 @@ class Fl_Graphics_Driver
 
     unsigned int                     stack_top_;
     struct region                    stack_[stack_max];
+    unsigned short const*            owner_map_;
+    unsigned int                     owner_cols_;
+    unsigned int                     owner_rows_;
+    unsigned short                   owner_;
+
+    unsigned int
+    owned_run(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int& o_skip) const;
 
     Fl_Graphics_Driver();
 
@@ -145,6 +156,20 @@ class Fl_Graphics_Driver
       unsigned int const i_len_x,
       unsigned int const i_len_y);
 
+    void
+    clip_owner(
+      unsigned short const* i_map,
+      unsigned int const i_cols,
+      unsigned int const i_rows,
+      unsigned short const i_owner);
+
+    bool
+    clip_owns(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y) const;
+
     void
     draw_fill(
       int const i_pos_x,
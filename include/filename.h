@@ -76,6 +76,13 @@ int fl_filename_expand(char* to, int tolen, const char* from);
 int fl_filename_absolute(char* to, int tolen, const char* from);
 int fl_filename_relative(char* to, int tolen, const char* from);
 int fl_filename_match(const char* name, const char* pattern);
+struct Fl_Filename_Pattern;
+struct Fl_Filename_Pattern* fl_filename_pattern_compile(const char* pattern);
+int fl_filename_pattern_match(const struct Fl_Filename_Pattern* pattern,
+                              const char* name);
+int fl_filename_pattern_filter(const struct Fl_Filename_Pattern* pattern,
+                               const char** names, int count);
+void fl_filename_pattern_free(struct Fl_Filename_Pattern* pattern);
 int fl_filename_isdir(const char* name);
 
 #  if defined(__cplusplus) && !defined(FL_DOXYGEN)
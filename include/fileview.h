@@ -0,0 +1,254 @@
+/*
+ fileview.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_File_View_H
+#define Fl_File_View_H
+
+#include <stddef.h>
+#include <stdio.h>
+#if !defined(__DOS__) && !defined(__NT__)
+#include <stdint.h>
+#endif
+#include "group.h"
+#include "scrlbar.h"
+
+/*
+  File offsets.  They are 64 bit everywhere, so the class is laid out
+  the same whatever the application defines _FILE_OFFSET_BITS to.  The
+  library converts them to off_t at the system calls, and gnu.mak
+  builds it with _FILE_OFFSET_BITS=64 so those take large files on
+  32-bit POSIX.  DOS only has the long offsets of fseek(), so files
+  from 2 GB up are refused there.
+*/
+#if defined(__DOS__) || defined(__NT__)
+typedef __int64 fl_off_t;
+#else
+typedef int64_t fl_off_t;
+#endif
+
+/*
+  Read-only viewer for files too large to load into an Fl_Text_Buffer.
+
+  The file is read through a small sliding window (memory mapped where
+  the platform allows it) and only the visible rows are ever decoded.
+  Lines are located through a sparse index holding one offset every
+  MARK_STRIDE lines, so memory stays flat regardless of file size.
+
+  Building the index and searching are done a slice at a time from an
+  idle callback, so the interface keeps responding while a large file
+  is scanned.  Lines are numbered from 1.
+*/
+class Fl_File_View : public Fl_Group
+{
+
+  public:
+
+    Fl_File_View(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      unsigned char const* i_label = 0L);
+
+    virtual
+    ~Fl_File_View();
+
+    int
+    load(
+      char const* i_path);
+
+    void
+    close();
+
+    fl_off_t
+    size() const
+    {
+      return size_;
+    }
+
+    long
+    lines() const;
+
+    bool
+    indexed() const
+    {
+      return (idx_off_ >= size_);
+    }
+
+    bool
+    busy() const
+    {
+      return (false == indexed() || searching_);
+    }
+
+    long
+    top_line() const
+    {
+      return top_ + 1;
+    }
+
+    void
+    top_line(
+      long const i_line);
+
+    void
+    search(
+      unsigned char const* i_text);
+
+    void
+    search_next();
+
+    void
+    search_cancel();
+
+    bool
+    searching() const
+    {
+      return searching_;
+    }
+
+    long
+    found_line() const
+    {
+      return found_ + 1;
+    }
+
+    virtual bool
+    handle(
+      enum Fl_Event const event);
+
+    virtual void
+    resize(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y);
+
+  protected:
+
+    enum
+    {
+      MARK_STRIDE = 256,
+      SLICE = 1 << 20,
+      SEARCH_MAX = 256,
+      TAB_WIDTH = 8
+    };
+
+    virtual void
+    draw();
+
+  private:
+
+#if defined(__DOS__) || defined(__NT__)
+    FILE* fp_;
+#else
+    int fd_;
+#endif
+    fl_off_t size_;
+    unsigned char* win_;
+    fl_off_t win_off_;
+    size_t win_len_;
+    size_t win_max_;
+
+    fl_off_t* marks_;
+    long nmarks_;
+    long amarks_;
+    fl_off_t idx_off_;
+    long nl_;
+    fl_off_t last_start_;
+    fl_off_t longest_;
+
+    long top_;
+    int hoff_;
+    long goto_;
+
+    unsigned char needle_[SEARCH_MAX];
+    size_t needle_len_;
+    fl_off_t search_off_;
+    long search_line_;
+    bool searching_;
+    long found_;
+
+    unsigned char* row_;
+    unsigned int row_len_;
+
+    Fl_Scrollbar* vscroll_;
+    Fl_Scrollbar* hscroll_;
+
+    struct
+    {
+      int x;
+      int y;
+      unsigned int w;
+      unsigned int h;
+    } text_area;
+
+    Fl_File_View(const Fl_File_View&);
+
+    Fl_File_View&
+    operator=(const Fl_File_View&);
+
+    unsigned char const*
+    fetch(
+      fl_off_t const i_offset,
+      size_t const i_need,
+      size_t* o_avail);
+
+    void
+    unmap();
+
+    fl_off_t
+    line_offset(
+      long const i_line);
+
+    fl_off_t
+    draw_row(
+      fl_off_t const i_offset,
+      int const i_pos_y,
+      enum Fl::foreground const i_fcolor,
+      enum Fl::background const i_bcolor);
+
+    void
+    index_slice();
+
+    void
+    search_slice();
+
+    void
+    search_start(
+      fl_off_t const i_offset,
+      long const i_line);
+
+    long
+    max_top() const;
+
+    void
+    scroll_to(
+      long const i_line);
+
+    void
+    update_scrollbars();
+
+    static void
+    idle_cb(
+      void* i_data);
+
+    static void
+    v_scrollbar_cb(
+      Fl_Scrollbar* i_bar,
+      Fl_File_View* i_view);
+
+    static void
+    h_scrollbar_cb(
+      Fl_Scrollbar* i_bar,
+      Fl_File_View* i_view);
+
+};
+
+#endif
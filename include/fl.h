@@ -79,6 +79,7 @@
 #include <string.h>
 #include "widget.h"
 
+class Fl_Menu_;
 class Fl_Window;
 class Fl_Screen_Driver;
 class Fl_System_Driver;
@@ -381,6 +382,27 @@ namespace Fl
   int event_inside(int, int, int, int);
   int event_inside(const Fl_Widget*);
   int test_shortcut(Fl_Shortcut);
+
+  /*
+    Shortcut registry.  Widgets bind the keys they answer to as
+    FL_SHORTCUT, so an unconsumed key is sent straight to its owners
+    instead of being broadcast over the widget tree.  A widget that takes
+    FL_SHORTCUT for keys it cannot name binds key 0, which keeps the
+    tree walk alive for every key.
+  */
+  enum shortcut_source
+  {
+    BIND_KEY = 1,
+    BIND_LABEL = 2,
+    BIND_MENU = 4,
+    BIND_ALL = 7
+  };
+
+  void add_shortcut(Fl_Widget*, unsigned int key, int source = BIND_KEY);
+  void remove_shortcut(Fl_Widget*, int sources = BIND_ALL);
+  void menu_shortcuts_changed(Fl_Menu_*);
+  int  find_shortcuts(Fl_Window const*, Fl_Widget*** owners);
+  bool walk_shortcut();
   bool handle(Fl_Event, Fl_Window*);
   bool handle_(Fl_Event, Fl_Window*);
 
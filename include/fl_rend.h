@@ -198,6 +198,22 @@ void fl_draw(
                     enum Fl::background const bcolor),
   int const draw_symbols = 1);
 
+void fl_draw(
+  struct fl_layout*& layout,
+  const unsigned char* str,
+  int const x,
+  int const y,
+  unsigned int const w,
+  unsigned int const h,
+  enum Fl_Label::Fl_Align const align,
+  enum Fl::foreground const fcolor,
+  enum Fl::background const bcolor,
+  enum Fl::foreground const hcolor);
+
+void fl_layout_clear(struct fl_layout* layout);
+
+void fl_layout_free(struct fl_layout*& layout);
+
 void fl_scroll(
   int const X,
   int const Y,
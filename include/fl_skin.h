@@ -69,6 +69,26 @@ namespace Fl
   extern struct skin_box _skin_box;
   extern struct skin_editor _skin_editor;
 
+  /*
+    Widgets point at the skins above instead of holding a copy, so
+    changing one of them recolors every widget that has not been given
+    colors of its own.  A widget with its own colors points at the copy
+    returned here, which is shared by all widgets using the same colors
+    and lives until the program exits.  The copy remembers which colors
+    differ from _skin_widget; the others follow it once skin_changed()
+    is called.
+  */
+  extern struct skin_widget const*
+  skin_intern(
+    struct skin_widget const& i_skin);
+
+  /*
+    Call after changing _skin_widget, so the interned copies take up
+    the new colors they have not overridden.
+  */
+  extern void
+  skin_changed();
+
 }
 
 #define __skin_h__
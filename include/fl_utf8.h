@@ -130,6 +130,8 @@ int fl_wcwidth_(unsigned int ucs);
 
 int fl_wcwidth(const char* src);
 
+int fl_utf8width(const char* src, int len);
+
 unsigned int fl_nonspacing(unsigned int ucs);
 
 unsigned fl_utf8to_mb(const char* src, unsigned srclen, char* dst,
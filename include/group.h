@@ -71,6 +71,7 @@
 #include "widget.h"
 
 class Fl_Rect;
+struct Fl_Hit_Grid;
 
 class Fl_Group : public Fl_Widget
 {
@@ -81,8 +82,15 @@ class Fl_Group : public Fl_Widget
     int children_;
     Fl_Rect* bounds_;
     int* sizes_;
+    Fl_Hit_Grid* hits_;
+
+    friend class Fl_Widget;
 
     int navigation(int const);
+    int hit_next(int const);
+    void hit_extent(const Fl_Widget&, int&, int&, int&, int&);
+    void hit_build();
+    void hit_clear();
     static Fl_Group* current_;
 
     Fl_Group(const Fl_Group&);
@@ -92,6 +100,7 @@ class Fl_Group : public Fl_Widget
     void draw();
     void draw_child(Fl_Widget& widget) const;
     void draw_children();
+    void draw_clipped(int const count, bool const update);
     void draw_outside_label(const Fl_Widget& widget) const ;
     void update_child(Fl_Widget& widget) const;
     Fl_Rect* bounds();
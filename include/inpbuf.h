@@ -17,15 +17,27 @@ struct inpbuf
   size_t m_data_size;
   unsigned char* m_data;
   struct inpbuf* m_next;
-  struct inpbuf* m_prev;
 };
 
+/*
+  Lines are kept in an array of pointers with a gap at the last edit,
+  so finding the nth line is a lookup and inserting or removing lines
+  near the cursor moves only the pointers between the old and new gap.
+  m_next only chains released lines on m_free.
+
+  The joined text is kept in m_string until a line changes.
+*/
 struct inplist
 {
-  struct inpbuf* m_head;
-  struct inpbuf* m_tail;
-  struct inpbuf* m_free;
+  struct inpbuf** m_line;
+  size_t m_alloc;
+  size_t m_gap;
+  size_t m_gap_end;
   size_t m_size;
+  struct inpbuf* m_free;
+  unsigned char* m_string;
+  size_t m_string_size;
+  int m_dirty;
 };
 
 #ifdef __cplusplus
@@ -59,12 +71,11 @@ inplist_remove(
 
 extern unsigned char*
 inplist_as_string(
-  struct inplist const* const i_list);
+  struct inplist* const io_list);
 
-extern size_t
-inplist_slot(
-  struct inplist const* const i_list,
-  struct inpbuf const* const i_buf);
+extern void
+inplist_touch(
+  struct inplist* const io_list);
 
 extern struct inpbuf*
 inplist_nth(
@@ -24,6 +24,7 @@ struct inpcur
 {
   struct inplist* m_list;
   struct inpbuf* m_active;
+  size_t m_line;
   unsigned int m_caret_x;
   unsigned int m_slot_x;
   unsigned int m_sticky_x;
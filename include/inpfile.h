@@ -70,6 +70,7 @@
 #define Fl_File_Input_H
 
 #include "input.h"
+#include "dircache.h"
 
 class Fl_File_Input : public Fl_Input
 {
@@ -77,10 +78,14 @@ class Fl_File_Input : public Fl_Input
     char    ok_entry_;
     short   buttons_[200];
     short   pressed_;
+    bool    complete_pending_;
 
     void    draw_buttons();
     int   handle_button(int event);
     void    update_buttons();
+    bool    complete();
+
+    static void list_cb(Fl_Dir_List* list, void* data);
 
   public:
 
@@ -91,6 +96,8 @@ class Fl_File_Input : public Fl_Input
       unsigned int const i_len_y,
       const unsigned char* i_label = 0L);
 
+    virtual ~Fl_File_Input();
+
     virtual bool handle(Fl_Event const event);
 
   protected:
@@ -72,6 +72,16 @@
 #include "widget.h"
 #include "menuitem.h"
 
+// one item for Fl_Menu_::add_many(), with the arguments of Fl_Menu_::add()
+struct Fl_Menu_Entry
+{
+  const unsigned char* label;
+  int shortcut;
+  Fl_Callback* callback;
+  void* user_data;
+  int flags;
+};
+
 class Fl_Menu_ : public Fl_Widget
 {
 
@@ -136,6 +146,7 @@ class Fl_Menu_ : public Fl_Widget
       return insert(index, a, fl_old_shortcut(b), c, d, e);
     }
     int  add(const unsigned char*);
+    int  add_many(const Fl_Menu_Entry* entries, int count);
     int  size() const ;
     void
     size(int W, int H)
@@ -146,16 +157,8 @@ class Fl_Menu_ : public Fl_Widget
     int clear_submenu(int index);
     void replace(int, const unsigned char*);
     void remove(int);
-    void
-    shortcut(int i, int s)
-    {
-      menu_[i].shortcut(s);
-    }
-    void
-    mode(int i, int fl)
-    {
-      menu_[i].flags = fl;
-    }
+    void shortcut(int i, int s);
+    void mode(int i, int fl);
     int
     mode(int i) const
     {
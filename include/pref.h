@@ -157,6 +157,12 @@ class Fl_Preferences
 
     void flush();
 
+    void journal( char on );
+    char journal();
+
+    void binary( char on );
+    char binary();
+
     class Name
     {
 
@@ -177,6 +183,12 @@ class Fl_Preferences
       char* name, *value;
     };
 
+    struct Buffer
+    {
+      char* data;
+      size_t size, alloc;
+    };
+
   private:
     Fl_Preferences() : node(0), rootNode(0) { }
     Fl_Preferences& operator=(const Fl_Preferences&);
@@ -204,15 +216,27 @@ class Fl_Preferences
         unsigned char indexed_: 1;
         Node** index_;
         int nIndex_, NIndex_;
+        int* entryHash_;
+        int NEntryHash_;
+        Node** childHash_;
+        int nChildHash_, NChildHash_;
+        int lazy_;
+        void loadLazy();
         void createIndex();
         void updateIndex();
         void deleteIndex();
+        void hashEntry( int ix );
+        void rehashEntries();
+        void hashChild( Node* nd );
+        void rehashChildren();
+        void deleteChildHash();
+        Node* findChild( const char* name, size_t len );
       public:
         static int lastEntrySet;
       public:
         Node( const char* path );
         ~Node();
-        int write( FILE* f );
+        void write( Buffer& b );
         const char* name();
         const char*
         path()
@@ -235,6 +259,16 @@ class Fl_Preferences
           root_ = r;
           top_ = 1;
         }
+        void
+        setLazy( int rec )
+        {
+          lazy_ = rec;
+        }
+        void
+        load()
+        {
+          if ( lazy_ >= 0 ) loadLazy();
+        }
         RootNode* findRoot();
         char remove();
         char dirty();
@@ -252,11 +286,13 @@ class Fl_Preferences
         int
         nEntry()
         {
+          load();
           return nEntry_;
         }
         Entry&
         entry(int i)
         {
+          load();
           return entry_[i];
         }
     };
@@ -267,6 +303,26 @@ class Fl_Preferences
         Fl_Preferences* prefs_;
         char* filename_;
         char* vendor_, *application_;
+        Buffer log_;
+        Node* logNode_;
+        long logSize_, fileSize_;
+        unsigned int fileHash_;
+        unsigned char journal_: 1;
+        unsigned char loading_: 1;
+        unsigned char compact_: 1;
+        unsigned char binary_: 1;
+        unsigned char reformat_: 1;
+        unsigned char mapped_: 1;
+        unsigned char* image_;
+        size_t imageSize_;
+        enum { JOURNAL_SLACK = 4096 };
+        enum { IMAGE_HEADER = 24, IMAGE_NODE = 20, IMAGE_ENTRY = 8 };
+        void parse( FILE* f, long stop );
+        int readImage( FILE* f );
+        void writeImage( Buffer& b );
+        void replay( FILE* f );
+        int writeFile();
+        int writeLog();
       public:
         RootNode( Fl_Preferences*, Root root, const char* vendor,
                   const char* application );
@@ -276,6 +332,23 @@ class Fl_Preferences
         ~RootNode();
         int read();
         int write();
+        void journal( char on );
+        char
+        journal()
+        {
+          return journal_;
+        }
+        void binary( char on );
+        char
+        binary()
+        {
+          return binary_;
+        }
+        char dirty();
+        void load( Node* nd, int rec );
+        void logEntry( Node* nd, const char* name, const char* value );
+        void logGroup( Node* nd );
+        void compact();
         char getPath( char* path, int pathlen );
     };
     friend class RootNode;
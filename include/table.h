@@ -0,0 +1,282 @@
+/*
+ table.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Table_H
+#define Fl_Table_H
+
+#include "group.h"
+#include "scrlbar.h"
+
+/*
+  Grid of cells that holds no data of its own.  A subclass draws each
+  cell in draw_cell(), which is only called for cells on screen.  Rows
+  are one line high; column widths are kept as running sums so finding
+  the column under a position is a binary search.
+
+  An optional header row (row -1) and header column (column -1) stay
+  in place while the cells scroll.  redraw_cell() repaints a single
+  cell, so a value that changes does not redraw the whole table.
+*/
+class Fl_Table : public Fl_Group
+{
+
+  public:
+
+    Fl_Table(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      unsigned char const* i_label = 0L);
+
+    virtual
+    ~Fl_Table();
+
+    long
+    rows() const
+    {
+      return rows_;
+    }
+
+    void
+    rows(
+      long const i_rows);
+
+    int
+    cols() const
+    {
+      return cols_;
+    }
+
+    void
+    cols(
+      int const i_cols);
+
+    unsigned int
+    col_width(
+      int const i_col) const;
+
+    void
+    col_width(
+      int const i_col,
+      unsigned int const i_width);
+
+    void
+    col_width_all(
+      unsigned int const i_width);
+
+    bool
+    row_header() const
+    {
+      return row_header_;
+    }
+
+    void
+    row_header(
+      bool const i_on);
+
+    unsigned int
+    row_header_width() const
+    {
+      return row_header_w_;
+    }
+
+    void
+    row_header_width(
+      unsigned int const i_width);
+
+    bool
+    col_header() const
+    {
+      return col_header_;
+    }
+
+    void
+    col_header(
+      bool const i_on);
+
+    long
+    top_row() const
+    {
+      return top_;
+    }
+
+    void
+    top_row(
+      long const i_row);
+
+    int
+    left_col() const
+    {
+      return x_to_col(left_);
+    }
+
+    void
+    left_col(
+      int const i_col);
+
+    void
+    redraw_cell(
+      long const i_row,
+      int const i_col);
+
+    void
+    redraw_range(
+      long const i_top,
+      long const i_bottom,
+      int const i_left,
+      int const i_right);
+
+    bool
+    find_cell(
+      int const i_pos_x,
+      int const i_pos_y,
+      long* o_row,
+      int* o_col) const;
+
+    long
+    callback_row() const
+    {
+      return cb_row_;
+    }
+
+    int
+    callback_col() const
+    {
+      return cb_col_;
+    }
+
+    virtual bool
+    handle(
+      enum Fl_Event const event);
+
+    virtual void
+    resize(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y);
+
+  protected:
+
+    enum
+    {
+      DEFAULT_WIDTH = 8,
+      DIRTY_MAX = 256
+    };
+
+    virtual void
+    draw_cell(
+      long const i_row,
+      int const i_col,
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y);
+
+    virtual void
+    draw();
+
+    int
+    x_to_col(
+      long const i_offset) const;
+
+  private:
+
+    struct cell
+    {
+      long row;
+      int col;
+    };
+
+    long rows_;
+    int cols_;
+    long* colx_;
+
+    bool row_header_;
+    unsigned int row_header_w_;
+    bool col_header_;
+
+    long top_;
+    long old_top_;
+    long left_;
+    long old_left_;
+
+    cell dirty_[DIRTY_MAX];
+    int ndirty_;
+
+    long cb_row_;
+    int cb_col_;
+
+    Fl_Scrollbar* vscroll_;
+    Fl_Scrollbar* hscroll_;
+
+    struct
+    {
+      int x;
+      int y;
+      unsigned int w;
+      unsigned int h;
+    } data_area;
+
+    Fl_Table(const Fl_Table&);
+
+    Fl_Table&
+    operator=(const Fl_Table&);
+
+    void
+    layout();
+
+    long
+    max_top() const;
+
+    long
+    max_left() const;
+
+    void
+    scroll_to(
+      long const i_row,
+      long const i_left);
+
+    bool
+    cell_visible(
+      long const i_row,
+      int const i_col) const;
+
+    void
+    draw_one(
+      long const i_row,
+      int const i_col);
+
+    void
+    update_scrollbars();
+
+    static void
+    draw_area(
+      void* i_data,
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      enum Fl::foreground const i_fcolor,
+      enum Fl::background const i_bcolor);
+
+    static void
+    v_scrollbar_cb(
+      Fl_Scrollbar* i_bar,
+      Fl_Table* i_table);
+
+    static void
+    h_scrollbar_cb(
+      Fl_Scrollbar* i_bar,
+      Fl_Table* i_table);
+
+};
+
+#endif
@@ -120,7 +120,7 @@ class Fl_Text_Display: public Fl_Group
 
     typedef void (*Unfinished_Style_Cb)(int, void*);
 
-    struct Fl::skin_editor skin_;
+    struct Fl::skin_editor const* skin_;
 
     Fl_Text_Display(
       int const i_pos_x,
@@ -262,11 +262,7 @@ class Fl_Text_Display: public Fl_Group
       return shortcut_;
     }
 
-    void
-    shortcut(int s)
-    {
-      shortcut_ = s;
-    }
+    void shortcut(int s);
 
     enum Fl::foreground
     textcolor() const
@@ -379,7 +375,11 @@ class Fl_Text_Display: public Fl_Group
     void update_v_scrollbar();
     void update_h_scrollbar();
     int measure_vline(int visLineNum) const;
+    int measure_line(int lineStartPos) const;
     int longest_vline() const;
+    void line_widths_rebuild();
+    void line_widths_update(int line, int nOldLines, int nNewLines,
+                            int lineStartPos);
     int empty_vlines() const;
     int vline_length(int visLineNum) const;
     int xy_to_position(int x, int y, int PosType = CHARACTER_POS) const;
@@ -434,6 +434,10 @@ class Fl_Text_Display: public Fl_Group
       unsigned int bottom;
     } mMargin;
     int* mLineStarts;
+    int* mLineWidths;
+    int mLineWidthsSize;
+    int mNLineWidths;
+    int mLineWidthsValid;
     int mTopLineNum;
     int mAbsTopLineNum;
     int mNeedAbsTopLineNum;
@@ -0,0 +1,296 @@
+/*
+ tree.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Tree_H
+#define Fl_Tree_H
+
+#include <stddef.h>
+#include "group.h"
+#include "scrlbar.h"
+
+class Fl_Tree;
+
+/*
+  Called the first time a branch is opened. It adds the children of
+  i_node with Fl_Tree::add().
+*/
+typedef void (Fl_Tree_Populate)(
+  Fl_Tree* i_tree,
+  int const i_node,
+  void* i_data);
+
+/*
+  Tree of text nodes without a widget per node.
+
+  Nodes live in one array and are named by their index; their labels
+  share a single text pool.  The rows on screen are found through a
+  flat list of the nodes currently shown, which opening or closing a
+  branch splices in place, so drawing and mouse hits only look at the
+  rows in view.
+
+  A node added as a branch with no children yet is filled in by the
+  populate callback when it is first opened.
+*/
+class Fl_Tree : public Fl_Group
+{
+
+  public:
+
+    Fl_Tree(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      unsigned char const* i_label = 0L);
+
+    virtual
+    ~Fl_Tree();
+
+    void
+    populate_callback(
+      Fl_Tree_Populate* i_cb,
+      void* i_data = 0)
+    {
+      populate_cb_ = i_cb;
+      populate_data_ = i_data;
+    }
+
+    int
+    add(
+      int const i_parent,
+      unsigned char const* i_label,
+      bool const i_branch = false);
+
+    void
+    clear();
+
+    int
+    nodes() const
+    {
+      return nnodes_;
+    }
+
+    unsigned char const*
+    label(
+      int const i_node) const;
+
+    int
+    parent(
+      int const i_node) const;
+
+    int
+    depth(
+      int const i_node) const;
+
+    bool
+    is_branch(
+      int const i_node) const;
+
+    bool
+    is_open(
+      int const i_node) const;
+
+    void
+    open(
+      int const i_node);
+
+    void
+    close(
+      int const i_node);
+
+    int
+    visible_rows() const
+    {
+      return nrows_;
+    }
+
+    int
+    row_node(
+      int const i_row) const
+    {
+      return (0 <= i_row && i_row < nrows_) ? rows_[i_row] : -1;
+    }
+
+    int
+    value() const
+    {
+      return row_node(value_);
+    }
+
+    void
+    value(
+      int const i_node);
+
+    int
+    top_row() const
+    {
+      return top_;
+    }
+
+    void
+    top_row(
+      int const i_row);
+
+    virtual bool
+    handle(
+      enum Fl_Event const event);
+
+    virtual void
+    resize(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y);
+
+  protected:
+
+    enum
+    {
+      INDENT = 2
+    };
+
+    virtual void
+    draw();
+
+  private:
+
+    enum
+    {
+      NODE_BRANCH = 1,
+      NODE_OPEN = 2,
+      NODE_POPULATED = 4
+    };
+
+    struct node
+    {
+      int parent;
+      int first;
+      int last;
+      int next;
+      int depth;
+      size_t label;
+      unsigned int flags;
+    };
+
+    Fl_Tree_Populate* populate_cb_;
+    void* populate_data_;
+
+    node* nodes_;
+    int nnodes_;
+    int anodes_;
+    int last_root_;
+
+    unsigned char* text_;
+    size_t ntext_;
+    size_t atext_;
+
+    int* rows_;
+    int nrows_;
+    int arows_;
+
+    int top_;
+    int old_top_;
+    int value_;
+
+    int dirty_first_;
+    int dirty_last_;
+
+    unsigned char* row_;
+    unsigned int row_len_;
+
+    Fl_Scrollbar* vscroll_;
+
+    struct
+    {
+      int x;
+      int y;
+      unsigned int w;
+      unsigned int h;
+    } text_area;
+
+    Fl_Tree(const Fl_Tree&);
+
+    Fl_Tree&
+    operator=(const Fl_Tree&);
+
+    bool
+    shown(
+      int const i_node) const;
+
+    int
+    find_row(
+      int const i_node) const;
+
+    int
+    subtree_end(
+      int const i_row) const;
+
+    int
+    next_shown(
+      int const i_node,
+      int const i_root) const;
+
+    bool
+    insert_rows(
+      int const i_row,
+      int const i_count);
+
+    void
+    open_row(
+      int const i_row);
+
+    void
+    close_row(
+      int const i_row);
+
+    int
+    max_top() const;
+
+    void
+    scroll_to(
+      int const i_row);
+
+    void
+    show_row(
+      int const i_row);
+
+    void
+    move_to(
+      int const i_row);
+
+    void
+    redraw_rows(
+      int const i_first,
+      int const i_last);
+
+    void
+    draw_row(
+      int const i_row);
+
+    void
+    update_scrollbar();
+
+    static void
+    draw_area(
+      void* i_data,
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      enum Fl::foreground const i_fcolor,
+      enum Fl::background const i_bcolor);
+
+    static void
+    scrollbar_cb(
+      Fl_Scrollbar* i_bar,
+      Fl_Tree* i_tree);
+
+};
+
+#endif
@@ -0,0 +1,261 @@
+/*
+ vbrowser.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Virtual_Browser_H
+#define Fl_Virtual_Browser_H
+
+#include <time.h>
+#include "group.h"
+#include "scrlbar.h"
+
+/*
+  Fills o_text with at most i_size bytes of UTF-8 for row i_row and
+  returns the number of bytes written.
+*/
+typedef unsigned int (Fl_Browser_Row)(
+  long const i_row,
+  unsigned char* o_text,
+  unsigned int const i_size,
+  void* i_data);
+
+/*
+  List that holds no rows of its own.  Only the row count is stored;
+  the text of each visible row is asked for from a callback when it is
+  drawn, so memory depends on the height of the widget and not on the
+  number of rows.
+
+  Rows are numbered from 0.  The selection is kept as a sorted list of
+  ranges.  Typing searches forward for a row starting with the typed
+  text, a slice at a time from an idle callback.  Scrolling moves the
+  rows already on screen and draws only the rows that come into view.
+*/
+class Fl_Virtual_Browser : public Fl_Group
+{
+
+  public:
+
+    Fl_Virtual_Browser(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      unsigned char const* i_label = 0L);
+
+    virtual
+    ~Fl_Virtual_Browser();
+
+    void
+    row_callback(
+      Fl_Browser_Row* i_cb,
+      void* i_data = 0)
+    {
+      row_cb_ = i_cb;
+      row_data_ = i_data;
+    }
+
+    long
+    rows() const
+    {
+      return rows_;
+    }
+
+    void
+    rows(
+      long const i_rows);
+
+    bool
+    multi() const
+    {
+      return multi_;
+    }
+
+    void
+    multi(
+      bool const i_multi)
+    {
+      multi_ = i_multi;
+    }
+
+    long
+    value() const
+    {
+      return value_;
+    }
+
+    void
+    value(
+      long const i_row);
+
+    long
+    top_row() const
+    {
+      return top_;
+    }
+
+    void
+    top_row(
+      long const i_row);
+
+    void
+    show_row(
+      long const i_row);
+
+    bool
+    selected(
+      long const i_row) const;
+
+    void
+    select(
+      long const i_first,
+      long const i_last,
+      bool const i_on = true);
+
+    void
+    select_none();
+
+    int
+    ranges() const
+    {
+      return nsel_;
+    }
+
+    bool
+    range(
+      int const i_index,
+      long* o_first,
+      long* o_last) const;
+
+    void
+    redraw_rows(
+      long const i_first,
+      long const i_last);
+
+    virtual bool
+    handle(
+      enum Fl_Event const event);
+
+    virtual void
+    resize(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y);
+
+  protected:
+
+    enum
+    {
+      FIND_MAX = 64,
+      SLICE = 4096
+    };
+
+    virtual void
+    draw();
+
+  private:
+
+    struct span
+    {
+      long first;
+      long last;
+    };
+
+    Fl_Browser_Row* row_cb_;
+    void* row_data_;
+    long rows_;
+    bool multi_;
+
+    long top_;
+    long old_top_;
+    long value_;
+    long anchor_;
+
+    span* sel_;
+    int nsel_;
+
+    long dirty_first_;
+    long dirty_last_;
+
+    unsigned char find_[FIND_MAX + 1];
+    unsigned int find_len_;
+    time_t find_time_;
+    long find_row_;
+    long find_left_;
+
+    unsigned char* row_;
+    unsigned int row_len_;
+
+    Fl_Scrollbar* vscroll_;
+
+    struct
+    {
+      int x;
+      int y;
+      unsigned int w;
+      unsigned int h;
+    } text_area;
+
+    Fl_Virtual_Browser(const Fl_Virtual_Browser&);
+
+    Fl_Virtual_Browser&
+    operator=(const Fl_Virtual_Browser&);
+
+    long
+    max_top() const;
+
+    void
+    scroll_to(
+      long const i_row);
+
+    void
+    move_to(
+      long const i_row,
+      bool const i_extend);
+
+    void
+    find(
+      unsigned char const* i_text,
+      unsigned int const i_len);
+
+    void
+    find_slice();
+
+    unsigned int
+    fetch(
+      long const i_row);
+
+    void
+    draw_row(
+      long const i_row);
+
+    void
+    update_scrollbar();
+
+    static void
+    draw_area(
+      void* i_data,
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y,
+      enum Fl::foreground const i_fcolor,
+      enum Fl::background const i_bcolor);
+
+    static void
+    idle_cb(
+      void* i_data);
+
+    static void
+    scrollbar_cb(
+      Fl_Scrollbar* i_bar,
+      Fl_Virtual_Browser* i_browser);
+
+};
+
+#endif
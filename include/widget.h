@@ -76,6 +76,7 @@
 class Fl_Widget;
 class Fl_Window;
 class Fl_Group;
+struct fl_layout;
 
 namespace Fl
 {
@@ -228,6 +229,7 @@ class Fl_Widget
     int x_, y_;
     unsigned int w_, h_;
     Fl_Label label_;
+    mutable struct fl_layout* layout_;
     Fl_Flags flags_;
     unsigned char type_;
     Fl_Damage damage_;
@@ -304,9 +306,11 @@ class Fl_Widget
       flags_ = static_cast<Fl_Flags>(bits);
     }
 
+    void update_label_shortcut();
+
   public:
 
-    struct Fl::skin_widget skin_;
+    struct Fl::skin_widget const* skin_;
 
     virtual ~Fl_Widget();
 
@@ -402,16 +406,12 @@ class Fl_Widget
       return label_.align_;
     }
 
-    void
-    align(enum Fl_Label::Fl_Align const alignment)
-    {
-      label_.align_ = alignment;
-    }
+    void align(enum Fl_Label::Fl_Align const alignment);
 
     void
     align(int const alignment)
     {
-      label_.align_ = static_cast<Fl_Label::Fl_Align>(alignment);
+      align(static_cast<Fl_Label::Fl_Align>(alignment));
     }
 
     bool
@@ -439,11 +439,7 @@ class Fl_Widget
     void copy_label(const unsigned char* new_label);
 
     void
-    label(Fl_Label::Fl_LabelType const a, const unsigned char* b)
-    {
-      label_.type = a;
-      label_.value = b;
-    }
+    label(Fl_Label::Fl_LabelType const a, const unsigned char* b);
 
     Fl_Label::Fl_LabelType
     labeltype() const
@@ -129,7 +129,7 @@ class Fl_Window : public Fl_Group
 
   public:
 
-    struct Fl::skin_box skin_;
+    struct Fl::skin_box const* skin_;
 
     Fl_Window(int const w, int const h, const unsigned char* title = 0);
 
@@ -82,6 +82,8 @@ class Fl_Menu_Window : public Fl_Single_Window
 
     void hide();
 
+    static void clear_cache();
+
     unsigned int
     overlay()
     {
@@ -68,7 +68,12 @@
 
 INCLUDES=-I../include -I../src/base/include -I../src/drivers/include
 
-DEFINES=-DFL_LIBRARY -D__CURSES__
+DEFINES=-DFL_LIBRARY -D__CURSES__ -D_FILE_OFFSET_BITS=64
+
+# make -f gnu.mak NCURSESW=1 builds against ncursesw (wide character cells)
+ifdef NCURSESW
+DEFINES+=-D__NCURSESW__
+endif
 
 OBJ=../obj
 SRC=../src
@@ -101,10 +106,12 @@ BASEOBJS=\
         $(OBJ)/drvscr.o \
         $(OBJ)/drvsys.o \
         $(OBJ)/drvwin.o \
+        $(OBJ)/winmap.o \
         $(OBJ)/fl_abort.o \
         $(OBJ)/fl_ask.o \
         $(OBJ)/fl.o \
         $(OBJ)/fl_grab.o \
+        $(OBJ)/fl_idle.o \
         $(OBJ)/fl_rect.o \
         $(OBJ)/fl_rend.o \
         $(OBJ)/fl_skin.o \
@@ -117,6 +124,7 @@ BASEOBJS=\
         $(OBJ)/fnisdir.o \
         $(OBJ)/fnlist.o \
         $(OBJ)/fnmatch.o \
+        $(OBJ)/fnpat.o \
         $(OBJ)/fnsetext.o \
         $(OBJ)/rint.o \
         $(OBJ)/scrxywh.o
@@ -148,6 +156,9 @@ DRIVERSRC=$(SRC)/drivers/nc
 
 FLTKOBJS=\
         $(OBJ)/fl_arg.o \
+        $(OBJ)/arena.o \
+        $(OBJ)/dirlist.o \
+        $(OBJ)/dircache.o \
         $(OBJ)/box.o \
         $(OBJ)/btn.o \
         $(OBJ)/btnk.o \
@@ -159,6 +170,7 @@ FLTKOBJS=\
         $(OBJ)/choice.o \
         $(OBJ)/compose.o \
         $(OBJ)/counter.o \
+        $(OBJ)/fileview.o \
         $(OBJ)/group.o \
         $(OBJ)/inpbuf.o \
         $(OBJ)/inpcur.o \
@@ -179,13 +191,17 @@ FLTKOBJS=\
         $(OBJ)/scrlbar.o \
         $(OBJ)/scroll.o \
         $(OBJ)/shortcut.o \
+        $(OBJ)/shortreg.o \
         $(OBJ)/slider.o \
         $(OBJ)/slvalue.o \
         $(OBJ)/spinner.o \
+        $(OBJ)/table.o \
         $(OBJ)/textbuf.o \
         $(OBJ)/textdsp.o \
+        $(OBJ)/tree.o \
         $(OBJ)/texted.o \
         $(OBJ)/valuator.o \
+        $(OBJ)/vbrowser.o \
         $(OBJ)/widget.o \
         $(OBJ)/win.o \
         $(OBJ)/windbl.o \
@@ -210,5 +226,11 @@ $(OBJ)/%.o : %.c
 $(OBJ)/%.o : %.cxx
 	$(CXX) -c $(CXXFLAGS) $< -o $@ 2> $(addsuffix .err,$@)
 
+# regenerates the character width table; the sources ship with CRLF
+.PHONY : width
+width :
+	$(CC) $(CFLAGS) -I$(XUTF8SRC) $(XUTF8SRC)/mkwidth.c -o $(OBJ)/mkwidth
+	$(OBJ)/mkwidth | sed 's/$$/\r/' > $(XUTF8SRC)/headers/width.h
+
 -include gnu.dep
 
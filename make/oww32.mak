@@ -91,10 +91,12 @@ BASEOBJS=&
         $(OBJ)\drvscr.obj &
         $(OBJ)\drvsys.obj &
         $(OBJ)\drvwin.obj &
+        $(OBJ)\winmap.obj &
         $(OBJ)\fl_abort.obj &
         $(OBJ)\fl_ask.obj &
         $(OBJ)\fl.obj &
         $(OBJ)\fl_grab.obj &
+        $(OBJ)\fl_idle.obj &
         $(OBJ)\fl_rect.obj &
         $(OBJ)\fl_rend.obj &
         $(OBJ)\fl_skin.obj &
@@ -107,6 +109,7 @@ BASEOBJS=&
         $(OBJ)\fnisdir.obj &
         $(OBJ)\fnlist.obj &
         $(OBJ)\fnmatch.obj &
+        $(OBJ)\fnpat.obj &
         $(OBJ)\fnsetext.obj &
         $(OBJ)\rint.obj &
         $(OBJ)\scrxywh.obj
@@ -139,6 +142,9 @@ DRIVERSRC=$(SRC)\drivers\ms
 
 FLTKOBJS=&
         $(OBJ)\fl_arg.obj &
+        $(OBJ)\arena.obj &
+        $(OBJ)\dirlist.obj &
+        $(OBJ)\dircache.obj &
         $(OBJ)\box.obj &
         $(OBJ)\btn.obj &
         $(OBJ)\btnk.obj &
@@ -150,6 +156,7 @@ FLTKOBJS=&
         $(OBJ)\choice.obj &
         $(OBJ)\compose.obj &
         $(OBJ)\counter.obj &
+        $(OBJ)\fileview.obj &
         $(OBJ)\group.obj &
         $(OBJ)\inpbuf.obj &
         $(OBJ)\inpcur.obj &
@@ -170,13 +177,17 @@ FLTKOBJS=&
         $(OBJ)\scrlbar.obj &
         $(OBJ)\scroll.obj &
         $(OBJ)\shortcut.obj &
+        $(OBJ)\shortreg.obj &
         $(OBJ)\slider.obj &
         $(OBJ)\slvalue.obj &
         $(OBJ)\spinner.obj &
+        $(OBJ)\table.obj &
         $(OBJ)\textbuf.obj &
         $(OBJ)\textdsp.obj &
+        $(OBJ)\tree.obj &
         $(OBJ)\texted.obj &
         $(OBJ)\valuator.obj &
+        $(OBJ)\vbrowser.obj &
         $(OBJ)\widget.obj &
         $(OBJ)\win.obj &
         $(OBJ)\windbl.obj &
@@ -206,6 +217,9 @@ $(OBJ)\drvsys.obj : $(BASESRC)\drvsys.cxx  .AUTODEPEND
         
 $(OBJ)\drvwin.obj : $(BASESRC)\drvwin.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\drvwin.cxx
+
+$(OBJ)\winmap.obj : $(BASESRC)\winmap.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\winmap.cxx
         
 $(OBJ)\fl_abort.obj : $(BASESRC)\fl_abort.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fl_abort.cxx
@@ -218,6 +232,9 @@ $(OBJ)\fl.obj : $(BASESRC)\fl.cxx  .AUTODEPEND
 	
 $(OBJ)\fl_grab.obj : $(BASESRC)\fl_grab.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fl_grab.cxx
+
+$(OBJ)\fl_idle.obj : $(BASESRC)\fl_idle.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fl_idle.cxx
         
 $(OBJ)\fl_rect.obj : $(BASESRC)\fl_rect.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fl_rect.cxx
@@ -254,6 +271,9 @@ $(OBJ)\fnlist.obj : $(BASESRC)\fnlist.cxx  .AUTODEPEND
         
 $(OBJ)\fnmatch.obj : $(BASESRC)\fnmatch.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fnmatch.cxx
+
+$(OBJ)\fnpat.obj : $(BASESRC)\fnpat.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fnpat.cxx
         
 $(OBJ)\fnsetext.obj : $(BASESRC)\fnsetext.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(BASESRC)\fnsetext.cxx
@@ -302,6 +322,15 @@ $(OBJ)\screen.obj : $(DRIVERSRC)\screen.c .AUTODEPEND
 
 $(OBJ)\fl_arg.obj : $(SRC)\fl_arg.cxx  .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\fl_arg.cxx
+
+$(OBJ)\arena.obj : $(SRC)\arena.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\arena.cxx
+
+$(OBJ)\dirlist.obj : $(SRC)\dirlist.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\dirlist.cxx
+
+$(OBJ)\dircache.obj : $(SRC)\dircache.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\dircache.cxx
 	
 $(OBJ)\box.obj : $(SRC)\box.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\box.cxx
@@ -336,6 +365,9 @@ $(OBJ)\compose.obj : $(SRC)\compose.cxx .AUTODEPEND
 $(OBJ)\counter.obj : $(SRC)\counter.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\counter.cxx
 
+$(OBJ)\fileview.obj : $(SRC)\fileview.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\fileview.cxx
+
 $(OBJ)\group.obj : $(SRC)\group.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\group.cxx
         
@@ -396,6 +428,9 @@ $(OBJ)\scroll.obj : $(SRC)\scroll.cxx .AUTODEPEND
 $(OBJ)\shortcut.obj : $(SRC)\shortcut.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\shortcut.cxx
 
+$(OBJ)\shortreg.obj : $(SRC)\shortreg.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\shortreg.cxx
+
 $(OBJ)\slider.obj : $(SRC)\slider.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\slider.cxx
 
@@ -405,18 +440,27 @@ $(OBJ)\slvalue.obj : $(SRC)\slvalue.cxx .AUTODEPEND
 $(OBJ)\spinner.obj : $(SRC)\spinner.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\spinner.cxx
 
+$(OBJ)\table.obj : $(SRC)\table.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\table.cxx
+
 $(OBJ)\textbuf.obj : $(SRC)\textbuf.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\textbuf.cxx
 
 $(OBJ)\textdsp.obj : $(SRC)\textdsp.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\textdsp.cxx
 
+$(OBJ)\tree.obj : $(SRC)\tree.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\tree.cxx
+
 $(OBJ)\texted.obj : $(SRC)\texted.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\texted.cxx
 
 $(OBJ)\valuator.obj : $(SRC)\valuator.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\valuator.cxx
 
+$(OBJ)\vbrowser.obj : $(SRC)\vbrowser.cxx .AUTODEPEND
+        *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\vbrowser.cxx
+
 $(OBJ)\widget.obj : $(SRC)\widget.cxx .AUTODEPEND
         *$(CXX) $(CXXFLAGS) -fo=$@ $(SRC)\widget.cxx
 
@@ -0,0 +1,97 @@
+/*
+ arena.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include "arena.h"
+#include <stdlib.h>
+
+Fl_Arena::Fl_Arena(
+  size_t const i_block_size) :
+  head_(0),
+  block_size_(i_block_size),
+  used_(0)
+{
+  return;
+}
+
+Fl_Arena::~Fl_Arena()
+{
+
+  while (head_)
+  {
+    block* next = head_->next;
+    free(head_);
+    head_ = next;
+  }
+
+  return;
+}
+
+void*
+Fl_Arena::allocate(
+  size_t const i_size)
+{
+  size_t count = (i_size + sizeof(align) - 1) / sizeof(align);
+  void* ptr = 0;
+
+  do
+  {
+
+    if (0 == head_ || (head_->fill + count) > head_->size)
+    {
+      size_t size = block_size_ / sizeof(align);
+
+      if (size < count)
+      {
+        size = count;
+      }
+
+      block* blk = (block*)malloc(sizeof(block) + (size - 1) * sizeof(align));
+
+      if (0 == blk)
+      {
+        break;
+      }
+
+      blk->next = head_;
+      blk->size = size;
+      blk->fill = 0;
+      head_ = blk;
+    }
+
+    ptr = &head_->data[head_->fill];
+    head_->fill += count;
+    used_ += count * sizeof(align);
+
+  }
+  while (0);
+
+  return ptr;
+}
+
+void
+Fl_Arena::clear()
+{
+
+  // keep the first block so the next use does not go back to malloc
+  while (head_ && head_->next)
+  {
+    block* next = head_->next;
+    free(head_);
+    head_ = next;
+  }
+
+  if (head_)
+  {
+    head_->fill = 0;
+  }
+
+  used_ = 0;
+
+  return;
+}
@@ -199,35 +199,41 @@ class Fl_System_Driver
     {
       return -1;
     }
-    virtual char*
-    getcwd(char* b, int l)
-    {
-      return NULL;
-    }
-    virtual int
-    chdir(const char* path)
-    {
-      return -1;
-    }
+    virtual char* getcwd(char* b, int l);
+    virtual int chdir(const char* path);
+    virtual int unlink(const char* fname);
     virtual int
-    unlink(const char* fname)
+    mkdir(const char* f, int mode)
     {
       return -1;
     }
     virtual int
-    mkdir(const char* f, int mode)
+    rmdir(const char* f)
     {
       return -1;
     }
+    virtual int rename(const char* f, const char* n);
+    // implement to report changes to directories; without a watch the
+    // caller has to look at the directory itself
     virtual int
-    rmdir(const char* f)
+    watch_directory(const char* path)
     {
       return -1;
     }
+    virtual void
+    unwatch_directory(int watch) {}
+    // implement to collect the changes reported for the watches; the
+    // screen driver calls it from its wait loop, so asking for them is
+    // only a test of what was collected
+    virtual void
+    poll_directories() {}
+    // stores the watches changed since the last call and returns how
+    // many, or -1 if changes were lost and every watch has to be taken
+    // as changed
     virtual int
-    rename(const char* f, const char* n)
+    changed_directories(int* watches, int max)
     {
-      return -1;
+      return 0;
     }
 
     // the default implementation of these utf8... functions should be enough
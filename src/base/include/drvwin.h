@@ -74,6 +74,7 @@
 #include "win.h"
 
 class Fl_X;
+struct block;
 
 /**
  \brief A base class for platform specific window handling code.
@@ -229,6 +230,18 @@ class Fl_Window_Driver
     virtual void destroy_double_buffer();
     virtual void show();
     virtual void show_menu();
+    /** Copies the cells of a drawn menu window, frame included; returns false if the driver cannot. */
+    virtual bool
+    save_menu(struct block* o_cells)
+    {
+      return false;
+    }
+    /** Puts back cells copied by save_menu() at the window's position; returns false if they do not fit. */
+    virtual bool
+    restore_menu(struct block const* i_cells)
+    {
+      return false;
+    }
     virtual void
     resize(int X, int Y, int W, int H) {}
     virtual void
@@ -189,12 +189,12 @@ enum scancodes
   SCAN_NONE                           = 0x00,
   SCAN_HOME                           = KEY_HOME,
   SCAN_UP                             = KEY_UP,
-  SCAN_PGUP                           = KEY_NPAGE,
+  SCAN_PGUP                           = KEY_PPAGE,
   SCAN_LEFT                           = KEY_LEFT,
   SCAN_RIGHT                          = KEY_RIGHT,
   SCAN_END                            = KEY_END,
   SCAN_DOWN                           = KEY_DOWN,
-  SCAN_PGDN                           = KEY_PPAGE,
+  SCAN_PGDN                           = KEY_NPAGE,
   SCAN_INS                            = KEY_IC,
   SCAN_DEL                            = KEY_DC,
   SCAN_SHIFT_TAB                      = KEY_BTAB,
@@ -247,12 +247,12 @@ enum scancodes
   SCAN_NONE                           = 0x00,
   SCAN_HOME                           = KEY_HOME,
   SCAN_UP                             = KEY_UP,
-  SCAN_PGUP                           = KEY_NPAGE,
+  SCAN_PGUP                           = KEY_PPAGE,
   SCAN_LEFT                           = KEY_LEFT,
   SCAN_RIGHT                          = KEY_RIGHT,
   SCAN_END                            = KEY_END,
   SCAN_DOWN                           = KEY_DOWN,
-  SCAN_PGDN                           = KEY_PPAGE,
+  SCAN_PGDN                           = KEY_NPAGE,
   SCAN_INS                            = KEY_IC,
   SCAN_DEL                            = KEY_DC,
   SCAN_SHIFT_TAB                      = KEY_BTAB,
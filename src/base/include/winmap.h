@@ -0,0 +1,78 @@
+/*
+ winmap.h
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#ifndef Fl_Window_Map_H
+#define Fl_Window_Map_H
+
+class Fl_Window;
+
+/*
+  Which top level window owns each cell of the screen: the topmost
+  shown window covering it, frame included.
+
+  Menu and tooltip windows are left out; they put back what was under
+  them themselves.  A subwindow draws into the cells of its top level
+  window.
+
+  The map is built again when a window is shown, hidden, moved,
+  resized or raised.  A window that gains cells is damaged whole and
+  cells no window owns any longer are cleared, so uncovered areas are
+  repainted.
+*/
+class Fl_Window_Map
+{
+
+  public:
+
+    static void
+    update();
+
+    static unsigned short
+    owner(
+      Fl_Window const* i_window);
+
+    static unsigned int
+    cells(
+      unsigned short const i_owner);
+
+    static void
+    clip(
+      unsigned short const i_owner);
+
+    static void
+    clear();
+
+  private:
+
+    struct entry
+    {
+      Fl_Window* window;
+      int pos_x;
+      int pos_y;
+      unsigned int len_x;
+      unsigned int len_y;
+      unsigned int cells;
+      bool exposed;
+    };
+
+    static entry* entries_;
+    static unsigned int count_;
+    static unsigned short* map_;
+    static unsigned int cols_;
+    static unsigned int rows_;
+
+    Fl_Window_Map();
+
+    static bool
+    mapped(
+      Fl_Window const* i_window);
+
+};
+
+#endif
@@ -70,6 +70,7 @@
 #include "drvgr.h"
 #include "fl_clip.h"
 #include "fl_skin.h"
+#include "fl_utf8.h"
 #include "screen.h"
 
 extern "C" void mouse_show();
@@ -98,11 +99,103 @@ Fl_Graphics_Driver::instance()
 }
 
 Fl_Graphics_Driver::Fl_Graphics_Driver() :
-  stack_top_(0)
+  stack_top_(0),
+  owner_map_(0),
+  owner_cols_(0),
+  owner_rows_(0),
+  owner_(0)
 {
   return;
 }
 
+/*
+  Restricts drawing to the cells of i_map holding i_owner, so a window
+  does not draw over the windows stacked above it.  A null map lifts
+  the restriction.  Cells outside the map are always drawn.
+*/
+void
+Fl_Graphics_Driver::clip_owner(
+  unsigned short const* i_map,
+  unsigned int const i_cols,
+  unsigned int const i_rows,
+  unsigned short const i_owner)
+{
+
+  owner_map_ = i_map;
+  owner_cols_ = i_cols;
+  owner_rows_ = i_rows;
+  owner_ = i_owner;
+
+  return;
+}
+
+bool
+Fl_Graphics_Driver::clip_owns(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y) const
+{
+  int l_pos_x = (i_pos_x + draw_offset_x);
+  int l_pos_y = (i_pos_y + draw_offset_y);
+  unsigned int l_row;
+  unsigned int l_skip;
+
+  for (l_row = 0; owner_map_ && i_len_x && i_len_y > l_row; l_row++)
+  {
+    if (i_len_x != owned_run(l_pos_x, (l_pos_y + l_row), i_len_x, l_skip))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+  Returns the length of the first run of cells in a row that may be
+  drawn, and in o_skip the number of cells before it that may not.
+*/
+unsigned int
+Fl_Graphics_Driver::owned_run(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int& o_skip) const
+{
+  unsigned short const* l_row;
+  unsigned int l_pos;
+  unsigned int l_end;
+  unsigned int l_start;
+
+  o_skip = 0;
+
+  if (0 == owner_map_ || 0 > i_pos_x || 0 > i_pos_y ||
+      owner_rows_ <= (unsigned int)i_pos_y)
+  {
+    return i_len_x;
+  }
+
+  l_row = &owner_map_[(i_pos_y * owner_cols_)];
+  l_pos = i_pos_x;
+  l_end = (i_pos_x + i_len_x);
+
+  while (l_end > l_pos && owner_cols_ > l_pos && owner_ != l_row[l_pos])
+  {
+    l_pos++;
+  }
+
+  o_skip = (l_pos - i_pos_x);
+  l_start = l_pos;
+
+  while (l_end > l_pos && (owner_cols_ <= l_pos || owner_ == l_row[l_pos]))
+  {
+    l_pos++;
+  }
+
+  return (l_pos - l_start);
+}
+
 bool
 Fl_Graphics_Driver::clip_intersects(
   int const i_pos_x,
@@ -423,10 +516,40 @@ Fl_Graphics_Driver::draw_fill(
   clip_box(l_pos_x, l_pos_y, l_len_x, l_len_y,
            i_pos_x, i_pos_y, i_len_x, i_len_y);
 
-  if (l_len_x && l_len_y)
+  if (0 == l_len_x || 0 == l_len_y)
+  {
+    return;
+  }
+
+  if (0 == owner_map_)
   {
     ::screen_fill_area(l_pos_x, l_pos_y, l_len_x, l_len_y,
                        i_char, _FG(i_fcolor), _BG(i_bcolor));
+    return;
+  }
+
+  for (unsigned int l_row = 0; l_len_y > l_row; l_row++)
+  {
+    int l_x = l_pos_x;
+    unsigned int l_left = l_len_x;
+
+    while (l_left)
+    {
+      unsigned int l_skip;
+      unsigned int l_run = owned_run(l_x, (l_pos_y + l_row), l_left, l_skip);
+
+      l_x += l_skip;
+      l_left -= l_skip;
+
+      if (l_run)
+      {
+        ::screen_fill_area(l_x, (l_pos_y + l_row), l_run, 1,
+                           i_char, _FG(i_fcolor), _BG(i_bcolor));
+      }
+
+      l_x += l_run;
+      l_left -= l_run;
+    }
   }
 
   return;
@@ -449,10 +572,22 @@ Fl_Graphics_Driver::draw_putc(
   clip_box(l_pos_x, l_pos_y, l_len_x, l_len_y,
            i_pos_x, i_pos_y, i_repeat_count, 1);
 
-  if (l_len_x && l_len_y)
+  while (l_len_x && l_len_y)
   {
-    ::screen_putc(l_pos_x, l_pos_y, i_char, l_len_x, _FG(i_fcolor),
-                  _BG(i_bcolor));
+    unsigned int l_skip;
+    unsigned int l_run = owned_run(l_pos_x, l_pos_y, l_len_x, l_skip);
+
+    l_pos_x += l_skip;
+    l_len_x -= l_skip;
+
+    if (l_run)
+    {
+      ::screen_putc(l_pos_x, l_pos_y, i_char, l_run, _FG(i_fcolor),
+                    _BG(i_bcolor));
+    }
+
+    l_pos_x += l_run;
+    l_len_x -= l_run;
   }
 
   return;
@@ -475,15 +610,59 @@ Fl_Graphics_Driver::draw_putvc(
   clip_box(l_pos_x, l_pos_y, l_len_x, l_len_y,
            i_pos_x, i_pos_y, 1, i_repeat_count);
 
-  if (l_len_x && l_len_y)
+  while (l_len_x && l_len_y)
   {
-    screen_putvc(l_pos_x, l_pos_y, i_char, l_len_y,
-                 _FG(i_fcolor), _BG(i_bcolor));
+    unsigned int l_skip;
+    unsigned int l_run = 0;
+
+    // a column is owned a cell at a time
+    while (l_len_y > l_run && owned_run(l_pos_x, (l_pos_y + l_run), 1, l_skip))
+    {
+      l_run++;
+    }
+
+    if (l_run)
+    {
+      screen_putvc(l_pos_x, l_pos_y, i_char, l_run,
+                   _FG(i_fcolor), _BG(i_bcolor));
+    }
+
+    else
+    {
+      l_run = 1;
+    }
+
+    l_pos_y += l_run;
+    l_len_y -= l_run;
   }
 
   return;
 }
 
+/*
+  Returns the cells taken by the character at i_string and its length
+  in o_len.  With ncursesw the screen decodes UTF-8; otherwise every
+  byte is a cell.
+*/
+inline static unsigned int
+char_cells(
+  unsigned char const* i_string,
+  unsigned char const* i_end,
+  int& o_len)
+{
+#if defined(__NCURSESW__)
+  int l_width = fl_wcwidth_(fl_utf8decode((char const*)i_string,
+                                          (char const*)i_end, &o_len));
+
+  return (0 > l_width) ? 1 : static_cast<unsigned int>(l_width);
+#else
+  (void)i_string;
+  (void)i_end;
+  o_len = 1;
+  return 1;
+#endif
+}
+
 void
 Fl_Graphics_Driver::draw_puts(
   int const i_pos_x,
@@ -497,20 +676,84 @@ Fl_Graphics_Driver::draw_puts(
   int l_pos_y;
   unsigned int l_len_x;
   unsigned int l_len_y;
-  unsigned int l_offset = 0;
+  unsigned char const* l_ptr = i_string;
+  unsigned char const* const l_end = (i_string + i_length);
+  int l_text_x = (i_pos_x + draw_offset_x);
+  int l_len;
+
+#if defined(__NCURSESW__)
+  unsigned int const l_cells = fl_utf8width((char const*)i_string, i_length);
+#else
+  unsigned int const l_cells = i_length;
+#endif
 
   clip_box(l_pos_x, l_pos_y, l_len_x, l_len_y,
-           i_pos_x, i_pos_y, i_length, 1);
+           i_pos_x, i_pos_y, l_cells, 1);
 
-  if (l_len_x && l_len_y)
+  // l_ptr is the character drawn at column l_text_x
+  while (l_len_x && l_len_y)
   {
-    if (0 > i_pos_x)
+    unsigned int l_skip;
+    unsigned int l_run = owned_run(l_pos_x, l_pos_y, l_len_x, l_skip);
+
+    l_pos_x += l_skip;
+    l_len_x -= l_skip;
+
+    // pass over the characters left of the run, and one cut by its start
+    while (l_end > l_ptr && l_text_x < l_pos_x)
+    {
+      l_text_x += char_cells(l_ptr, l_end, l_len);
+      l_ptr += l_len;
+    }
+
+    while (l_end > l_ptr && 0 == char_cells(l_ptr, l_end, l_len))
+    {
+      l_ptr += l_len;
+    }
+
+    if (l_run)
     {
-      l_offset = (i_length - l_len_x);
+      int const l_stop = (l_pos_x + l_run);
+      unsigned char const* l_start = l_ptr;
+      int const l_start_x = l_text_x;
+
+      // the cells of a wide character cut by the start are cleared
+      if (l_text_x > l_pos_x)
+      {
+        ::screen_putc(l_pos_x, l_pos_y, ' ',
+                      ((l_text_x < l_stop) ? l_text_x : l_stop) - l_pos_x,
+                      _FG(i_fcolor), _BG(i_bcolor));
+      }
+
+      while (l_end > l_ptr)
+      {
+        unsigned int l_width = char_cells(l_ptr, l_end, l_len);
+
+        if (l_text_x + (int)l_width > l_stop)
+        {
+          break;
+        }
+
+        l_text_x += l_width;
+        l_ptr += l_len;
+      }
+
+      if (l_ptr > l_start)
+      {
+        ::screen_puts(l_start_x, l_pos_y, l_start, (unsigned int)(l_ptr - l_start),
+                      _FG(i_fcolor), _BG(i_bcolor));
+      }
+
+      // and so is the part of one cut by the end
+      if (l_end > l_ptr && l_text_x < l_stop)
+      {
+        ::screen_putc(l_text_x, l_pos_y, ' ', (l_stop - l_text_x),
+                      _FG(i_fcolor), _BG(i_bcolor));
+      }
     }
 
-    ::screen_puts(l_pos_x, l_pos_y, i_string + l_offset, l_len_x,
-                  _FG(i_fcolor), _BG(i_bcolor));
+    l_pos_x += l_run;
+    l_len_x -= l_run;
   }
 
 }
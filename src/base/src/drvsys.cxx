@@ -71,6 +71,11 @@
 #include <stdarg.h>
 #include <string.h>
 #include <time.h>
+#if defined(__WATCOMC__)
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
 #include "drvsys.h"
 #include "fl.h"
 #include "fl_utf8.h"
@@ -721,6 +726,30 @@ Fl_System_Driver::fopen(const char* f, const char* mode)
   return ::fopen(f, mode);
 }
 
+char*
+Fl_System_Driver::getcwd(char* b, int l)
+{
+  return ::getcwd(b, l);
+}
+
+int
+Fl_System_Driver::chdir(const char* path)
+{
+  return ::chdir(path);
+}
+
+int
+Fl_System_Driver::unlink(const char* fname)
+{
+  return ::remove(fname);
+}
+
+int
+Fl_System_Driver::rename(const char* f, const char* n)
+{
+  return ::rename(f, n);
+}
+
 void
 Fl_System_Driver::open_callback(void (*)(const char*))
 {
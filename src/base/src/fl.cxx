@@ -77,6 +77,7 @@
 #include "fl_abi.h"
 #include "platform.h"
 #include "win.h"
+#include "winmap.h"
 
 #include "flstring.h"
 
@@ -761,8 +762,18 @@ _flush(Fl_X* i)
 
     if (wi->damage())
     {
-      // wi->driver()->flush();
-      Fl_Window_Driver::driver(wi)->flush();
+      unsigned short owner = Fl_Window_Map::owner(wi);
+
+      // a window hidden behind others has no cells to draw into; it is
+      // damaged again when it gains some
+      if (0 == owner || Fl_Window_Map::cells(owner))
+      {
+        Fl_Window_Map::clip(owner);
+        // wi->driver()->flush();
+        Fl_Window_Driver::driver(wi)->flush();
+        Fl_Window_Map::clip(0);
+      }
+
       wi->clear_damage();
     }
   }
@@ -771,7 +782,8 @@ _flush(Fl_X* i)
   return;
 }
 
-// escalates damage bits if a window overlaps another
+// escalates damage bits if a window overlaps another that may draw over
+// it; windows in the window map keep to their own cells
 // returns number of damaged (dirty) windows
 static int
 flush_propogate(Fl_X* i)
@@ -794,9 +806,17 @@ flush_propogate(Fl_X* i)
     {
       if (0 == (Fl_Widget::FL_DAMAGE_ALL & wi->damage()))
       {
+        unsigned short owner = Fl_Window_Map::owner(wi);
+
         for (Fl_X* n = i->next; n; n = n->next)
         {
           Fl_Window* nw = n->w;
+          unsigned short nowner = Fl_Window_Map::owner(nw);
+
+          if (owner && nowner && owner != nowner)
+          {
+            continue;
+          }
 
           if (nw->damage())
           {
@@ -836,6 +856,8 @@ flush_propogate(Fl_X* i)
 void
 Fl::flush()
 {
+  Fl_Window_Map::update();
+
   if (damage() && Fl_X::first)
   {
     damage_ = 0;
@@ -1648,24 +1670,44 @@ Fl::handle_(Fl_Event e, Fl_Window* window)
         break;
       }
 
-      // Try it as shortcut, sending to mouse widget and all parents:
-      wi = find_active(belowmouse()); // STR #3216
-
-      if (!wi)
+      if (walk_shortcut())
       {
-        wi = modal();
+        // Try it as shortcut, sending to mouse widget and all parents:
+        wi = find_active(belowmouse()); // STR #3216
 
-        if (!wi) wi = window;
-      }
+        if (!wi)
+        {
+          wi = modal();
 
-      else if (wi->window() != first_window())
-      {
-        if (send_event(FL_SHORTCUT, first_window(), first_window())) return true;
+          if (!wi) wi = window;
+        }
+
+        else if (wi->window() != first_window())
+        {
+          if (send_event(FL_SHORTCUT, first_window(), first_window())) return true;
+        }
+
+        for (; wi; wi = wi->parent())
+        {
+          if (send_event(FL_SHORTCUT, wi, wi->window())) return true;
+        }
       }
 
-      for (; wi; wi = wi->parent())
+      else
       {
-        if (send_event(FL_SHORTCUT, wi, wi->window())) return true;
+        // Only the widgets bound to this key are offered it:
+        Fl_Widget** owner = 0;
+        int count = find_shortcuts(window, &owner);
+        bool used = false;
+
+        for (int i = 0; i < count && !used; i++)
+        {
+          used = (0 != send_event(FL_SHORTCUT, owner[i], owner[i]->window()));
+        }
+
+        free(owner);
+
+        if (used) return true;
       }
 
       // try using add_handle() functions:
@@ -459,6 +459,247 @@ fl_draw(
     Fl::clip_pop();
 }
 
+struct fl_layout_line
+{
+  size_t offset;
+  unsigned int length;
+  unsigned int pos_x;
+  int underline;
+};
+
+// the lines follow the header in the same block, and the text follows
+// the lines, so a layout is a single allocation
+struct fl_layout
+{
+  const unsigned char* str;
+  enum Fl_Label::Fl_Align align;
+  unsigned int w;
+  unsigned int h;
+  char shortcut;
+  int lines;
+  unsigned int pos_y;
+  size_t size;
+};
+
+static struct fl_layout_line*
+layout_lines(struct fl_layout* o)
+{
+  return (struct fl_layout_line*)(o + 1);
+}
+
+static unsigned char*
+layout_text(struct fl_layout* o)
+{
+  return (unsigned char*)(layout_lines(o) + o->lines);
+}
+
+/*
+  Stores the line just expanded by expand_text_() as line i of o, the
+  text going at offset used.
+*/
+static void
+layout_line(
+  struct fl_layout* o,
+  int const i,
+  size_t const used,
+  const unsigned char* linebuf,
+  int const buflen,
+  double const width,
+  unsigned int const w,
+  enum Fl_Label::Fl_Align const align)
+{
+  struct fl_layout_line* line = &layout_lines(o)[i];
+
+  memcpy(layout_text(o) + used, linebuf, buflen);
+  line->offset = used;
+  line->length = buflen;
+
+  // same arithmetic as fl_draw(), so an oversized label lands where it did
+  if (align & Fl_Label::FL_ALIGN_LEFT) line->pos_x = 0;
+
+  else if (align & Fl_Label::FL_ALIGN_RIGHT) line->pos_x = w - (int)(width + .5);
+
+  else line->pos_x = (w - (int)(width + .5)) / 2;
+
+  line->underline = -1;
+
+  if (underline_at && underline_at >= linebuf
+      && underline_at < (linebuf + buflen))
+  {
+    line->underline = (int)(underline_at - linebuf);
+  }
+}
+
+/*
+  Splits str into lines the way fl_draw() does and keeps the expanded
+  text with the offset of each line inside a w by h box. Labels with
+  '@' symbols are not laid out here and are drawn by fl_draw() instead.
+  The lines are counted first so the block is sized once; a label of
+  one line, the usual case, is not expanded a second time.
+*/
+static bool
+layout_build(
+  struct fl_layout*& layout,
+  const unsigned char* str,
+  unsigned int const w,
+  unsigned int const h,
+  enum Fl_Label::Fl_Align const align)
+{
+  unsigned char* linebuf = NULL;
+  const unsigned char* p;
+  const unsigned char* e;
+  int buflen;
+  double width;
+  int lines = 0;
+  size_t used = 0;
+
+  for (p = str; ; p = e)
+  {
+    e = expand_text_(p, linebuf, 0, w, buflen, width,
+                     align & Fl_Label::FL_ALIGN_WRAP, 1);
+    lines++;
+    used += buflen;
+
+    if (!*e) break;
+  }
+
+  size_t size = sizeof(*layout) + lines * sizeof(struct fl_layout_line) + used;
+
+  if (!layout || layout->size < size)
+  {
+    struct fl_layout* o = (struct fl_layout*)realloc(layout, size);
+
+    if (!o)
+    {
+      if (layout) layout->str = 0;
+
+      return false;
+    }
+
+    layout = o;
+    layout->size = size;
+  }
+
+  struct fl_layout* o = layout;
+
+  o->lines = lines;
+
+  if (1 == lines)
+  {
+    layout_line(o, 0, 0, linebuf, buflen, width, w, align);
+  }
+
+  else
+  {
+    int i = 0;
+
+    used = 0;
+
+    for (p = str; i < lines; p = e, i++)
+    {
+      e = expand_text_(p, linebuf, 0, w, buflen, width,
+                       align & Fl_Label::FL_ALIGN_WRAP, 1);
+      layout_line(o, i, used, linebuf, buflen, width, w, align);
+      used += buflen;
+    }
+  }
+
+  if (align & Fl_Label::FL_ALIGN_BOTTOM) o->pos_y = h - 2 - (o->lines - 1);
+
+  else if (align & Fl_Label::FL_ALIGN_TOP) o->pos_y = 1;
+
+  else o->pos_y = (h - o->lines) / 2;
+
+  o->str = str;
+  o->align = align;
+  o->w = w;
+  o->h = h;
+  o->shortcut = fl_draw_shortcut;
+
+  return true;
+}
+
+/**
+  Draws a label like fl_draw(), keeping its expanded lines in \p layout
+  between calls. The lines are laid out again when the string pointer,
+  alignment, box size or shortcut mode differ from the last call, or
+  after fl_layout_clear(). \p layout is allocated on first use and is
+  released with fl_layout_free().
+*/
+void
+fl_draw(
+  struct fl_layout*& layout,
+  const unsigned char* str,
+  int const x,
+  int const y,
+  unsigned int const w,
+  unsigned int const h,
+  enum Fl_Label::Fl_Align const align,
+  enum Fl::foreground const fcolor,
+  enum Fl::background const bcolor,
+  enum Fl::foreground const hcolor)
+{
+  if (!str || !*str) return;
+
+  if (strchr((char const*)str, '@'))
+  {
+    fl_draw(str, x, y, w, h, align, fcolor, bcolor, hcolor);
+    return;
+  }
+
+  if (w && h && !Fl::clip_intersects(x, y, w, h)
+      && (align & Fl_Label::FL_ALIGN_INSIDE)) return;
+
+  if (!layout || layout->str != str || layout->align != align || layout->w != w
+      || layout->h != h || layout->shortcut != fl_draw_shortcut)
+  {
+    if (!layout_build(layout, str, w, h, align))
+    {
+      fl_draw(str, x, y, w, h, align, fcolor, bcolor, hcolor);
+      return;
+    }
+  }
+
+  if (align & Fl_Label::FL_ALIGN_CLIP)
+    Fl::clip_push(x, y, w, h);
+
+  int ypos = y + layout->pos_y;
+
+  for (int i = 0; i < layout->lines; i++, ypos++)
+  {
+    struct fl_layout_line const* line = &layout_lines(layout)[i];
+    unsigned char const* text = layout_text(layout) + line->offset;
+    int xpos = x + line->pos_x;
+
+    Fl::draw_puts(xpos, ypos, text, line->length, fcolor, bcolor);
+
+    if (0 <= line->underline)
+      Fl::draw_puts(xpos + line->underline, ypos, text + line->underline, 1,
+                    hcolor, bcolor);
+  }
+
+  if (align & Fl_Label::FL_ALIGN_CLIP)
+    Fl::clip_pop();
+}
+
+/** Makes the next fl_draw() with \p layout lay the label out again. */
+void
+fl_layout_clear(struct fl_layout* layout)
+{
+  if (layout) layout->str = 0;
+}
+
+/** Releases a layout kept by fl_draw() and sets \p layout to NULL. */
+void
+fl_layout_free(struct fl_layout*& layout)
+{
+  if (layout)
+  {
+    free(layout);
+    layout = 0;
+  }
+}
+
 /**
   Measure how wide and tall the string will be when printed by the
   fl_draw() function with \p align parameter. If the incoming \p w
@@ -8,6 +8,8 @@
  from: United States.
 */
 #include "fl_skin.h"
+#include <stdlib.h>
+#include <string.h>
 
 struct Fl::skin_symbols Fl::_skin_sym =
 {
@@ -64,3 +66,126 @@ struct Fl::skin_editor Fl::_skin_editor =
   /* lineno_bcolor */ Fl::bcolor_light_gray,
   /* lineno_fcolor */ Fl::fcolor_black
 };
+
+// the colors of a skin, each with the bit that marks it as a pooled
+// skin's own when it differs from Fl::_skin_widget; the colors not
+// marked follow Fl::_skin_widget through Fl::skin_changed()
+#define SKIN_FIELDS(F) \
+  F(normal_bcolor, 0x0001) \
+  F(normal_fcolor, 0x0002) \
+  F(focused_bcolor, 0x0004) \
+  F(focused_fcolor, 0x0008) \
+  F(highlight_fcolor, 0x0010) \
+  F(disabled_fcolor, 0x0020) \
+  F(menu_bcolor, 0x0040) \
+  F(menu_fcolor, 0x0080) \
+  F(box_bcolor, 0x0100) \
+  F(box_fcolor, 0x0200)
+
+struct skin_node
+{
+  struct Fl::skin_widget skin;
+  unsigned int own;
+  struct skin_node* next;
+};
+
+class skin_pool
+{
+
+  public:
+
+    struct skin_node* head;
+
+    skin_pool() :
+      head(0)
+    {
+    }
+
+    ~skin_pool()
+    {
+      while (head)
+      {
+        struct skin_node* next = head->next;
+        free(head);
+        head = next;
+      }
+    }
+
+};
+
+static skin_pool _skin_pool;
+
+static unsigned int
+skin_own(
+  struct Fl::skin_widget const& i_skin)
+{
+  unsigned int own = 0;
+
+#define SKIN_OWN(field, bit) \
+  if (i_skin.field != Fl::_skin_widget.field) own |= bit;
+  SKIN_FIELDS(SKIN_OWN)
+#undef SKIN_OWN
+
+  return own;
+}
+
+struct Fl::skin_widget const*
+Fl::skin_intern(
+  struct Fl::skin_widget const& i_skin)
+{
+  struct Fl::skin_widget const* skin = &Fl::_skin_widget;
+  unsigned int own = skin_own(i_skin);
+  struct skin_node* node = _skin_pool.head;
+
+  if (0 == own)
+  {
+    return skin;
+  }
+
+  while (node)
+  {
+    if (own == node->own &&
+        0 == memcmp(&node->skin, &i_skin, sizeof(i_skin)))
+    {
+      break;
+    }
+
+    node = node->next;
+  }
+
+  if (0 == node)
+  {
+    node = (struct skin_node*)malloc(sizeof(*node));
+
+    if (node)
+    {
+      node->skin = i_skin;
+      node->own = own;
+      node->next = _skin_pool.head;
+      _skin_pool.head = node;
+    }
+  }
+
+  if (node)
+  {
+    skin = &node->skin;
+  }
+
+  return skin;
+}
+
+void
+Fl::skin_changed()
+{
+  struct skin_node* node;
+
+  for (node = _skin_pool.head; node; node = node->next)
+  {
+#define SKIN_REBASE(field, bit) \
+    if (0 == (node->own & bit)) node->skin.field = Fl::_skin_widget.field;
+    SKIN_FIELDS(SKIN_REBASE)
+#undef SKIN_REBASE
+  }
+
+  return;
+}
@@ -1199,21 +1199,19 @@ fl_utf8test(const char* src, unsigned srclen)
   return ret;
 }
 
-/* forward declare mk_wcwidth() as static so the name is not visible.
+/* two-level width table generated by xutf8/mkwidth.c from Markus Kuhn's
+   mk_wcwidth()
  */
-static int mk_wcwidth(unsigned int ucs);
+#include "xutf8/headers/width.h"
 
-/* include the c source directly so its contents are only visible here
- */
-#include "xutf8/wcwidth.c"
-
-/** Wrapper to adapt Markus Kuhn's implementation of wcwidth() for FLTK.
+/** Returns the display width of a Unicode character.
   \param [in] ucs Unicode character value
   \returns width of character in columns
 
-  See http://www.cl.cam.ac.uk/~mgk25/ucs/wcwidth.c for Markus Kuhn's
-  original implementation of wcwidth() and wcswidth()
-  (defined in IEEE Std 1002.1-2001) for Unicode.
+  The width comes from a table lookup instead of a search, see
+  xutf8/headers/width.h. It follows Markus Kuhn's implementation of
+  wcwidth() (http://www.cl.cam.ac.uk/~mgk25/ucs/wcwidth.c), with wide
+  emoji counted as two columns.
 
   \b WARNING: this function returns widths for "raw" Unicode characters.
   It does not even try to map C1 control characters (0x80 to 0x9F) to
@@ -1223,7 +1221,22 @@ static int mk_wcwidth(unsigned int ucs);
 int
 fl_wcwidth_(unsigned int ucs)
 {
-  return mk_wcwidth(ucs);
+  unsigned int bits;
+
+  if (0x7f > ucs)
+  {
+    return (0x20 <= ucs) ? 1 : (ucs ? -1 : 0);
+  }
+
+  if (0x10ffff < ucs)
+  {
+    return 1;
+  }
+
+  bits = ucs_width_block[ucs_width_index[ucs >> 8]][(ucs & 0xff) >> 2];
+  bits = (bits >> ((ucs & 3) << 1)) & 3;
+
+  return (3 == bits) ? -1 : (int)bits;
 }
 
 /** extended wrapper around  fl_wcwidth_(unsigned int ucs) function.
@@ -1249,6 +1262,40 @@ fl_wcwidth(const char* src)
   return width;
 }
 
+/** Returns the number of columns a UTF-8 string takes on the screen.
+  \param[in] src pointer to start of UTF-8 byte sequence
+  \param[in] len number of bytes in \p src
+  \returns width of the string in columns
+
+  ASCII is counted one column per byte without decoding. Control
+  characters and bytes that are not valid UTF-8 take one column.
+*/
+int
+fl_utf8width(const char* src, int len)
+{
+  const char* p = src;
+  const char* e = src + len;
+  int width = 0;
+
+  while (p < e)
+  {
+    if (!(*p & 0x80))
+    {
+      width++;
+      p++;
+      continue;
+    }
+
+    int l;
+    unsigned ucs = fl_utf8decode(p, e, &l);
+    int w = fl_wcwidth_(ucs);
+    width += (w < 0) ? 1 : w;
+    p += l;
+  }
+
+  return width;
+}
+
 /**
   Converts a UTF-8 string into a wide character string.
 
@@ -70,6 +70,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include "drvsys.h"
+#include "dircache.h"
 #include "fl.h"
 #include "filename.h"
 #include "flstring.h"
@@ -82,12 +83,18 @@
    fl_filename_isdir("/etc");   // returns non-zero
    fl_filename_isdir("/etc/hosts"); // returns 0
    \endcode
+   A name in a directory listed by Fl_Dir_Cache is answered from the
+   listing without looking at the file system.
    \param[in] n the filename to parse
    \return non zero if file exists and is a directory, zero otherwise
 */
 int
 fl_filename_isdir(const char* n)
 {
+  int isdir = Fl_Dir_Cache::isdir(n);
+
+  if (isdir >= 0) return isdir;
+
   return Fl::system_driver()->filename_isdir(n);
 }
 
@@ -134,5 +141,5 @@ Fl_System_Driver::filename_isdir(const char* n)
     n = fn;
   }
 
-  return !stat(n, &s) && (s.st_mode & S_IFDIR);
+  return !::stat(n, &s) && (s.st_mode & S_IFDIR);
 }
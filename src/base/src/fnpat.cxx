@@ -0,0 +1,737 @@
+/*
+ fnpat.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include "filename.h"
+#include <ctype.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+  A pattern is compiled into a position automaton: every character
+  class in the pattern ('x', '?', '[set]' or '*') is one position, and
+  the positions that may follow each one are kept as a bit set.  The
+  set of positions reached after each character of a name is found
+  from the previous set with no backtracking, so a name is matched in
+  time linear in its length whatever the pattern.
+
+  Patterns made of plain characters and '*' also keep their leading
+  and trailing text, which every matching name must start and end
+  with.  That check rejects most names before the automaton runs, and
+  settles "name", "prefix*" and "*suffix" patterns on its own.
+*/
+
+typedef unsigned long pattern_word;
+
+enum
+{
+  PATTERN_BITS = sizeof(pattern_word) * CHAR_BIT
+};
+
+enum pattern_kind
+{
+  PATTERN_LITERAL, /* no wildcards: the prefix is the whole pattern */
+  PATTERN_AFFIX, /* prefix*suffix */
+  PATTERN_AUTOMATON
+};
+
+struct Fl_Filename_Pattern
+{
+  enum pattern_kind kind;
+  char* prefix;
+  size_t prefix_len;
+  char const* suffix;
+  size_t suffix_len;
+  int positions;
+  int words;
+  int nullable;
+  pattern_word* first;
+  pattern_word* last;
+  pattern_word* follow;
+  pattern_word* accept;
+  pattern_word* state;
+};
+
+/*
+  Nullable flag, first and last positions of a part of the pattern.
+*/
+struct pattern_part
+{
+  int nullable;
+  pattern_word* first;
+  pattern_word* last;
+};
+
+struct pattern_parse
+{
+  Fl_Filename_Pattern* pattern;
+  char const* p;
+};
+
+static int
+part_init(
+  Fl_Filename_Pattern const* i_pattern,
+  struct pattern_part* o_part)
+{
+  o_part->nullable = 1;
+  o_part->first = (pattern_word*)calloc(2 * i_pattern->words,
+                                        sizeof(pattern_word));
+  o_part->last = o_part->first + i_pattern->words;
+
+  return (0 != o_part->first);
+}
+
+static void
+part_free(
+  struct pattern_part* io_part)
+{
+  free(io_part->first);
+  io_part->first = 0;
+  io_part->last = 0;
+
+  return;
+}
+
+static void
+set_or(
+  pattern_word* io_to,
+  pattern_word const* i_from,
+  int const i_words)
+{
+  int l_word;
+
+  for (l_word = 0; i_words > l_word; l_word++)
+  {
+    io_to[l_word] |= i_from[l_word];
+  }
+
+  return;
+}
+
+/*
+  Appends i_part to io_seq: every position that can end io_seq may be
+  followed by every position that can start i_part.
+*/
+static void
+part_append(
+  Fl_Filename_Pattern* io_pattern,
+  struct pattern_part* io_seq,
+  struct pattern_part const* i_part)
+{
+  int const l_words = io_pattern->words;
+  int l_pos;
+  int l_word;
+
+  for (l_pos = 0; io_pattern->positions > l_pos; l_pos++)
+  {
+    if (io_seq->last[l_pos / PATTERN_BITS] &
+        ((pattern_word)1 << (l_pos % PATTERN_BITS)))
+    {
+      set_or(io_pattern->follow + l_pos * l_words, i_part->first, l_words);
+    }
+  }
+
+  if (io_seq->nullable)
+  {
+    set_or(io_seq->first, i_part->first, l_words);
+  }
+
+  if (i_part->nullable)
+  {
+    set_or(io_seq->last, i_part->last, l_words);
+  }
+
+  else
+  {
+    for (l_word = 0; l_words > l_word; l_word++)
+    {
+      io_seq->last[l_word] = i_part->last[l_word];
+    }
+  }
+
+  io_seq->nullable = io_seq->nullable && i_part->nullable;
+
+  return;
+}
+
+/*
+  Appends a position matching the characters marked in i_set.  A '*'
+  is a position that may follow itself and need not be matched.
+*/
+static void
+add_position(
+  struct pattern_parse* io_parse,
+  struct pattern_part* io_seq,
+  unsigned char const* i_set,
+  int const i_star)
+{
+  Fl_Filename_Pattern* l_pattern = io_parse->pattern;
+  int const l_words = l_pattern->words;
+  int const l_pos = l_pattern->positions++;
+  int const l_word = l_pos / PATTERN_BITS;
+  pattern_word const l_bit = (pattern_word)1 << (l_pos % PATTERN_BITS);
+  pattern_word l_sets[2 * (FL_PATH_MAX / PATTERN_BITS + 1)];
+  struct pattern_part l_part;
+  int l_char;
+
+  for (l_char = 1; UCHAR_MAX >= l_char; l_char++)
+  {
+    if (i_set[l_char])
+    {
+      l_pattern->accept[l_char * l_words + l_word] |= l_bit;
+    }
+  }
+
+  if (i_star)
+  {
+    l_pattern->follow[l_pos * l_words + l_word] |= l_bit;
+  }
+
+  memset(l_sets, 0, 2 * l_words * sizeof(pattern_word));
+  l_part.nullable = i_star;
+  l_part.first = l_sets;
+  l_part.last = l_sets + l_words;
+  l_part.first[l_word] = l_bit;
+  l_part.last[l_word] = l_bit;
+
+  part_append(l_pattern, io_seq, &l_part);
+
+  return;
+}
+
+/*
+  Reads "[set]" the way fl_filename_match() does, so ']' or '-' first
+  in the set are plain characters and "a-d-f" runs from 'a' to 'f'.
+*/
+static void
+parse_set(
+  struct pattern_parse* io_parse,
+  unsigned char* o_set)
+{
+  char const* l_start = io_parse->p;
+  char const* l_p = l_start;
+  int l_reverse = ('^' == *l_start || '!' == *l_start);
+  int l_char;
+
+  if (l_reverse)
+  {
+    l_start++;
+  }
+
+  for (l_char = 1; UCHAR_MAX >= l_char; l_char++)
+  {
+    char const l_s = (char)l_char;
+    int l_matched = 0;
+    char l_last = 0;
+
+    l_p = l_start;
+
+    while (*l_p)
+    {
+      if ('-' == *l_p && l_last && l_p[1])
+      {
+        l_p++;
+
+        if (l_s <= *l_p && l_s >= l_last)
+        {
+          l_matched = 1;
+        }
+
+        l_last = 0;
+      }
+
+      else if (l_s == *l_p)
+      {
+        l_matched = 1;
+      }
+
+      l_last = *l_p++;
+
+      if (']' == *l_p)
+      {
+        break;
+      }
+    }
+
+    o_set[l_char] = (unsigned char)(l_matched != l_reverse);
+  }
+
+  io_parse->p = (*l_p) ? l_p + 1 : l_p;
+
+  return;
+}
+
+/*
+  Skips what is left of "|pattern|pattern}" up to and past the brace
+  that closes it.
+*/
+static void
+skip_alternatives(
+  struct pattern_parse* io_parse)
+{
+  char const* l_p = io_parse->p;
+  int l_depth = 0;
+
+  while (*l_p && 0 <= l_depth)
+  {
+    switch (*l_p++)
+    {
+      case '\\':
+        if (*l_p)
+        {
+          l_p++;
+        }
+
+        break;
+
+      case '{':
+        l_depth++;
+        break;
+
+      case '}':
+        l_depth--;
+        break;
+    }
+  }
+
+  io_parse->p = l_p;
+
+  return;
+}
+
+static int
+parse_sequence(
+  struct pattern_parse* io_parse,
+  struct pattern_part* io_seq,
+  int const i_nested);
+
+/*
+  Reads "{X|Y|Z}" after the opening brace as the union of its
+  alternatives.
+*/
+static int
+parse_alternatives(
+  struct pattern_parse* io_parse,
+  struct pattern_part* io_seq)
+{
+  Fl_Filename_Pattern* l_pattern = io_parse->pattern;
+  struct pattern_part l_union;
+  struct pattern_part l_alt;
+  int l_end;
+
+  if (!part_init(l_pattern, &l_union))
+  {
+    return 0;
+  }
+
+  l_union.nullable = 0;
+
+  do
+  {
+    if (!part_init(l_pattern, &l_alt))
+    {
+      part_free(&l_union);
+      return 0;
+    }
+
+    l_end = parse_sequence(io_parse, &l_alt, 1);
+
+    if (0 > l_end)
+    {
+      part_free(&l_alt);
+      part_free(&l_union);
+      return 0;
+    }
+
+    l_union.nullable = l_union.nullable || l_alt.nullable;
+    set_or(l_union.first, l_alt.first, l_pattern->words);
+    set_or(l_union.last, l_alt.last, l_pattern->words);
+    part_free(&l_alt);
+  }
+  while ('|' == l_end);
+
+  part_append(l_pattern, io_seq, &l_union);
+  part_free(&l_union);
+
+  return 1;
+}
+
+/*
+  Reads characters into io_seq until the end of the pattern or, when
+  i_nested, the end of one alternative.  Returns '|' or '}' for the
+  end of an alternative, 0 for the end of the pattern and -1 when out
+  of memory.
+*/
+static int
+parse_sequence(
+  struct pattern_parse* io_parse,
+  struct pattern_part* io_seq,
+  int const i_nested)
+{
+  unsigned char l_set[UCHAR_MAX + 1];
+  int l_char;
+
+  for (;;)
+  {
+    char const l_c = *io_parse->p;
+
+    if (0 == l_c)
+    {
+      return 0;
+    }
+
+    io_parse->p++;
+
+    switch (l_c)
+    {
+      case '?':
+        memset(l_set, 1, sizeof(l_set));
+        add_position(io_parse, io_seq, l_set, 0);
+        break;
+
+      case '*':
+        memset(l_set, 1, sizeof(l_set));
+        add_position(io_parse, io_seq, l_set, 1);
+        break;
+
+      case '[':
+        parse_set(io_parse, l_set);
+        add_position(io_parse, io_seq, l_set, 0);
+        break;
+
+      case '{':
+        if (!parse_alternatives(io_parse, io_seq))
+        {
+          return -1;
+        }
+
+        break;
+
+      case '|':
+      case ',':
+        if (i_nested)
+        {
+          return '|';
+        }
+
+        skip_alternatives(io_parse);
+        break;
+
+      case '}':
+        if (i_nested)
+        {
+          return '}';
+        }
+
+        break;
+
+      default:
+      {
+        int l_fold = tolower((unsigned char)l_c);
+
+        if ('\\' == l_c && *io_parse->p)
+        {
+          l_fold = tolower((unsigned char)*io_parse->p++);
+        }
+
+        for (l_char = 1; UCHAR_MAX >= l_char; l_char++)
+        {
+          l_set[l_char] = (unsigned char)(l_fold == tolower(l_char));
+        }
+
+        add_position(io_parse, io_seq, l_set, 0);
+      }
+      break;
+    }
+  }
+}
+
+static int
+equal_fold(
+  char const* i_a,
+  char const* i_b,
+  size_t i_len)
+{
+  for (; i_len; i_len--, i_a++, i_b++)
+  {
+    if (tolower((unsigned char)*i_a) != tolower((unsigned char)*i_b))
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/*
+  Finds the text before the first and after the last '*' of a pattern
+  with no other special characters.
+*/
+static void
+find_affixes(
+  Fl_Filename_Pattern* io_pattern,
+  char const* i_pattern)
+{
+  char const* l_first;
+  char const* l_last;
+
+  io_pattern->kind = PATTERN_AUTOMATON;
+
+  if (strpbrk(i_pattern, "?[]{}|,\\"))
+  {
+    return;
+  }
+
+  l_first = strchr(i_pattern, '*');
+
+  if (0 == l_first)
+  {
+    io_pattern->kind = PATTERN_LITERAL;
+    io_pattern->prefix_len = strlen(i_pattern);
+    return;
+  }
+
+  l_last = strrchr(i_pattern, '*');
+  io_pattern->prefix_len = (size_t)(l_first - i_pattern);
+  io_pattern->suffix = io_pattern->prefix + (l_last + 1 - i_pattern);
+  io_pattern->suffix_len = strlen(l_last + 1);
+
+  if (l_first == l_last)
+  {
+    io_pattern->kind = PATTERN_AFFIX;
+  }
+
+  return;
+}
+
+/**
+    Compiles a pattern for fl_filename_pattern_match().
+    The syntax is the same as for fl_filename_match(), but a compiled
+    pattern matches a name in time linear in the length of the name,
+    however many '*' or alternatives the pattern has, so it is the one
+    to use when the same pattern is tried on many names.
+
+    \param[in] pattern the string pattern
+    \return the compiled pattern, to be given back with
+    fl_filename_pattern_free(), or 0 if out of memory
+*/
+Fl_Filename_Pattern*
+fl_filename_pattern_compile(const char* pattern)
+{
+  Fl_Filename_Pattern* l_pattern;
+  struct pattern_parse l_parse;
+  struct pattern_part l_root;
+  size_t l_len = strlen(pattern);
+  int l_words;
+
+  if (FL_PATH_MAX < l_len)
+  {
+    return 0;
+  }
+
+  l_pattern = (Fl_Filename_Pattern*)calloc(1, sizeof(*l_pattern));
+
+  if (0 == l_pattern)
+  {
+    return 0;
+  }
+
+  /* every position takes at least one character of the pattern */
+  l_words = (int)(l_len / PATTERN_BITS) + 1;
+  l_pattern->words = l_words;
+  l_pattern->prefix = (char*)malloc(l_len + 1);
+  l_pattern->first = (pattern_word*)calloc(
+                       (4 + l_len + UCHAR_MAX + 1) * l_words,
+                       sizeof(pattern_word));
+
+  if (0 == l_pattern->prefix || 0 == l_pattern->first)
+  {
+    fl_filename_pattern_free(l_pattern);
+    return 0;
+  }
+
+  l_pattern->last = l_pattern->first + l_words;
+  l_pattern->state = l_pattern->last + l_words;
+  l_pattern->follow = l_pattern->state + 2 * l_words;
+  l_pattern->accept = l_pattern->follow + l_len * l_words;
+
+  memcpy(l_pattern->prefix, pattern, l_len + 1);
+  l_pattern->suffix = l_pattern->prefix + l_len;
+  find_affixes(l_pattern, pattern);
+
+  if (PATTERN_AUTOMATON == l_pattern->kind)
+  {
+    if (!part_init(l_pattern, &l_root))
+    {
+      fl_filename_pattern_free(l_pattern);
+      return 0;
+    }
+
+    l_parse.pattern = l_pattern;
+    l_parse.p = pattern;
+
+    if (0 > parse_sequence(&l_parse, &l_root, 0))
+    {
+      part_free(&l_root);
+      fl_filename_pattern_free(l_pattern);
+      return 0;
+    }
+
+    l_pattern->nullable = l_root.nullable;
+    memcpy(l_pattern->first, l_root.first, l_words * sizeof(pattern_word));
+    memcpy(l_pattern->last, l_root.last, l_words * sizeof(pattern_word));
+    part_free(&l_root);
+  }
+
+  return l_pattern;
+}
+
+/**
+    Checks if a string \p s matches a pattern compiled with
+    fl_filename_pattern_compile().
+
+    \param[in] pattern the compiled pattern
+    \param[in] s the string to check for a match
+    \return non zero if the string matches the pattern
+*/
+int
+fl_filename_pattern_match(const Fl_Filename_Pattern* pattern, const char* s)
+{
+  int const l_words = pattern->words;
+  pattern_word* l_cur = pattern->state;
+  pattern_word* l_next = pattern->state + l_words;
+  pattern_word* l_swap;
+  pattern_word l_any;
+  size_t l_len = strlen(s);
+  int l_pos;
+  int l_word;
+
+  if (l_len < pattern->prefix_len + pattern->suffix_len ||
+      !equal_fold(s, pattern->prefix, pattern->prefix_len) ||
+      !equal_fold(s + l_len - pattern->suffix_len, pattern->suffix,
+                  pattern->suffix_len))
+  {
+    return 0;
+  }
+
+  if (PATTERN_LITERAL == pattern->kind)
+  {
+    return (l_len == pattern->prefix_len);
+  }
+
+  if (PATTERN_AFFIX == pattern->kind)
+  {
+    return 1;
+  }
+
+  if (0 == l_len)
+  {
+    return pattern->nullable;
+  }
+
+  for (l_word = 0; l_words > l_word; l_word++)
+  {
+    l_cur[l_word] = pattern->first[l_word];
+  }
+
+  for (;;)
+  {
+    pattern_word const* l_accept =
+      pattern->accept + (unsigned char)*s++ * l_words;
+
+    l_any = 0;
+
+    for (l_word = 0; l_words > l_word; l_word++)
+    {
+      l_cur[l_word] &= l_accept[l_word];
+      l_any |= l_cur[l_word];
+    }
+
+    if (0 == l_any)
+    {
+      return 0;
+    }
+
+    if (0 == *s)
+    {
+      break;
+    }
+
+    memset(l_next, 0, l_words * sizeof(pattern_word));
+
+    for (l_pos = 0; pattern->positions > l_pos; l_pos++)
+    {
+      if (l_cur[l_pos / PATTERN_BITS] &
+          ((pattern_word)1 << (l_pos % PATTERN_BITS)))
+      {
+        set_or(l_next, pattern->follow + l_pos * l_words, l_words);
+      }
+    }
+
+    l_swap = l_cur;
+    l_cur = l_next;
+    l_next = l_swap;
+  }
+
+  for (l_word = 0; l_words > l_word; l_word++)
+  {
+    if (l_cur[l_word] & pattern->last[l_word])
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+    Keeps the names that match a compiled pattern.
+    The matching names are moved to the front of \p names in the order
+    they were in.
+
+    \param[in] pattern the compiled pattern
+    \param[in,out] names the names to check
+    \param[in] count the number of names
+    \return the number of names that match
+*/
+int
+fl_filename_pattern_filter(const Fl_Filename_Pattern* pattern,
+                           const char** names, int count)
+{
+  int l_kept = 0;
+  int l_index;
+
+  for (l_index = 0; count > l_index; l_index++)
+  {
+    if (fl_filename_pattern_match(pattern, names[l_index]))
+    {
+      names[l_kept++] = names[l_index];
+    }
+  }
+
+  return l_kept;
+}
+
+/**
+    Frees a pattern compiled with fl_filename_pattern_compile().
+
+    \param[in] pattern the compiled pattern, may be 0
+*/
+void
+fl_filename_pattern_free(Fl_Filename_Pattern* pattern)
+{
+  if (pattern)
+  {
+    free(pattern->prefix);
+    free(pattern->first);
+    free(pattern);
+  }
+
+  return;
+}
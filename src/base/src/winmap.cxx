@@ -0,0 +1,275 @@
+/*
+ winmap.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include "winmap.h"
+#include "drvgr.h"
+#include "fl_draw.h"
+#include "platform.h"
+#include "screen.h"
+#include <stdlib.h>
+
+Fl_Window_Map::entry* Fl_Window_Map::entries_ = 0;
+unsigned int Fl_Window_Map::count_ = 0;
+unsigned short* Fl_Window_Map::map_ = 0;
+unsigned int Fl_Window_Map::cols_ = 0;
+unsigned int Fl_Window_Map::rows_ = 0;
+
+bool
+Fl_Window_Map::mapped(
+  Fl_Window const* i_window)
+{
+  return (0 == i_window->window() &&
+          i_window->visible() &&
+          0 == i_window->menu_window() &&
+          0 == i_window->tooltip_window());
+}
+
+static void
+window_area(
+  Fl_Window const* i_window,
+  int& o_pos_x,
+  int& o_pos_y,
+  unsigned int& o_len_x,
+  unsigned int& o_len_y)
+{
+
+  o_pos_x = i_window->x();
+  o_pos_y = i_window->y();
+  o_len_x = i_window->w();
+  o_len_y = i_window->h();
+
+  if (i_window->get_border())
+  {
+    o_pos_x--;
+    o_pos_y--;
+    o_len_x += 2;
+    o_len_y += 2;
+  }
+
+  return;
+}
+
+/*
+  Builds the map again if the shown windows were stacked, placed or
+  sized differently since it was last built.  Called before windows
+  are drawn.
+*/
+void
+Fl_Window_Map::update()
+{
+  unsigned int l_cols = _video_cols;
+  unsigned int l_rows = _video_rows;
+  bool l_same = (map_ && l_cols == cols_ && l_rows == rows_);
+  unsigned int l_count = 0;
+  Fl_X* l_x;
+  int l_pos_x;
+  int l_pos_y;
+  unsigned int l_len_x;
+  unsigned int l_len_y;
+
+  for (l_x = Fl_X::first; l_x; l_x = l_x->next)
+  {
+    if (false == mapped(l_x->w))
+    {
+      continue;
+    }
+
+    if (l_same)
+    {
+      window_area(l_x->w, l_pos_x, l_pos_y, l_len_x, l_len_y);
+
+      l_same = (count_ > l_count &&
+                entries_[l_count].window == l_x->w &&
+                entries_[l_count].pos_x == l_pos_x &&
+                entries_[l_count].pos_y == l_pos_y &&
+                entries_[l_count].len_x == l_len_x &&
+                entries_[l_count].len_y == l_len_y);
+    }
+
+    l_count++;
+  }
+
+  if (l_same && l_count == count_)
+  {
+    return;
+  }
+
+  unsigned short* l_map =
+    (unsigned short*)calloc((l_cols * l_rows) + 1, sizeof(unsigned short));
+  entry* l_entries =
+    (entry*)malloc((l_count + 1) * sizeof(entry));
+
+  if (0 == l_map || 0 == l_entries || 0xffff <= l_count)
+  {
+    free(l_map);
+    free(l_entries);
+    return;
+  }
+
+  unsigned int l_index = 0;
+
+  for (l_x = Fl_X::first; l_x; l_x = l_x->next)
+  {
+    if (mapped(l_x->w))
+    {
+      entry& l_entry = l_entries[l_index++];
+
+      l_entry.window = l_x->w;
+      window_area(l_x->w, l_entry.pos_x, l_entry.pos_y,
+                  l_entry.len_x, l_entry.len_y);
+      l_entry.cells = 0;
+      l_entry.exposed = false;
+    }
+  }
+
+  // the front window is first in the list, so it is laid down last
+  for (l_index = l_count; l_index--;)
+  {
+    entry const& l_entry = l_entries[l_index];
+    int l_x1 = (0 > l_entry.pos_x) ? 0 : l_entry.pos_x;
+    int l_y1 = (0 > l_entry.pos_y) ? 0 : l_entry.pos_y;
+    int l_x2 = (l_entry.pos_x + (int)l_entry.len_x);
+    int l_y2 = (l_entry.pos_y + (int)l_entry.len_y);
+
+    if ((int)l_cols < l_x2) l_x2 = l_cols;
+
+    if ((int)l_rows < l_y2) l_y2 = l_rows;
+
+    for (int l_y = l_y1; l_y2 > l_y; l_y++)
+    {
+      for (int l_x = l_x1; l_x2 > l_x; l_x++)
+      {
+        l_map[(l_y * l_cols) + l_x] = (unsigned short)(l_index + 1);
+      }
+    }
+  }
+
+  // repaint the cells that changed hands
+  bool l_whole = (0 == map_ || l_cols != cols_ || l_rows != rows_);
+
+  for (unsigned int l_y = 0; l_rows > l_y; l_y++)
+  {
+    for (unsigned int l_x = 0; l_cols > l_x; l_x++)
+    {
+      unsigned int l_cell = ((l_y * l_cols) + l_x);
+      unsigned short l_id = l_map[l_cell];
+      unsigned short l_old_id = l_whole ? 0 : map_[l_cell];
+      Fl_Window* l_new = l_id ? l_entries[l_id - 1].window : 0;
+      Fl_Window* l_old = l_old_id ? entries_[l_old_id - 1].window : 0;
+
+      if (l_id)
+      {
+        l_entries[l_id - 1].cells++;
+      }
+
+      if (l_new == l_old)
+      {
+        continue;
+      }
+
+      if (l_new)
+      {
+        l_entries[l_id - 1].exposed = true;
+      }
+
+      else
+      {
+        Fl::draw_fill(l_x, l_y, 1, 1, 0x20, Fl::fcolor_white, Fl::bcolor_black);
+      }
+    }
+  }
+
+  for (l_index = 0; l_count > l_index; l_index++)
+  {
+    if (l_entries[l_index].exposed)
+    {
+      l_entries[l_index].window->damage(Fl_Widget::FL_DAMAGE_ALL);
+    }
+  }
+
+  free(map_);
+  free(entries_);
+  map_ = l_map;
+  entries_ = l_entries;
+  count_ = l_count;
+  cols_ = l_cols;
+  rows_ = l_rows;
+
+  return;
+}
+
+/*
+  Returns the owner of the cells i_window draws into, or 0 if it is not
+  in the map and may draw anywhere.
+*/
+unsigned short
+Fl_Window_Map::owner(
+  Fl_Window const* i_window)
+{
+  Fl_Window const* l_top = i_window;
+
+  while (l_top->window())
+  {
+    l_top = l_top->window();
+  }
+
+  for (unsigned int l_index = 0; count_ > l_index; l_index++)
+  {
+    if (entries_[l_index].window == l_top)
+    {
+      return (unsigned short)(l_index + 1);
+    }
+  }
+
+  return 0;
+}
+
+unsigned int
+Fl_Window_Map::cells(
+  unsigned short const i_owner)
+{
+  return (i_owner && count_ >= i_owner) ? entries_[i_owner - 1].cells : 0;
+}
+
+/*
+  Keeps drawing inside the cells of i_owner, or lifts the restriction
+  if it is 0.
+*/
+void
+Fl_Window_Map::clip(
+  unsigned short const i_owner)
+{
+
+  if (i_owner)
+  {
+    Fl::gr().clip_owner(map_, cols_, rows_, i_owner);
+  }
+
+  else
+  {
+    Fl::gr().clip_owner(0, 0, 0, 0);
+  }
+
+  return;
+}
+
+void
+Fl_Window_Map::clear()
+{
+
+  free(map_);
+  free(entries_);
+  map_ = 0;
+  entries_ = 0;
+  count_ = 0;
+  cols_ = 0;
+  rows_ = 0;
+
+  return;
+}
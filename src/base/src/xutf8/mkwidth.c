@@ -0,0 +1,177 @@
+/*
+ mkwidth.c
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+
+/*
+  Writes headers/width.h, the display width table read by fl_wcwidth_(),
+  to standard output. Run from make/ with:
+
+    make -f gnu.mak width
+
+  The widths come from mk_wcwidth() in wcwidth.c and the non-spacing
+  marks in headers/spacing.h. Both sources are compiled in here so the
+  table can never drift from them.
+*/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "wcwidth.c"
+#include "spacing.c"
+
+/*
+  Code points in U+1F000 to U+1FAFF that EastAsianWidth.txt (Unicode
+  14.0) lists as Wide. mk_wcwidth() predates most emoji and reports
+  them as one column; terminals draw them across two.
+*/
+static struct interval const emoji_wide[] = {
+  { 0x1F004, 0x1F004 }, { 0x1F02C, 0x1F02F }, { 0x1F094, 0x1F09F },
+  { 0x1F0AF, 0x1F0B0 }, { 0x1F0C0, 0x1F0C0 }, { 0x1F0CF, 0x1F0D0 },
+  { 0x1F0F6, 0x1F0FF }, { 0x1F18E, 0x1F18E }, { 0x1F191, 0x1F19A },
+  { 0x1F1AE, 0x1F1E5 }, { 0x1F200, 0x1F320 }, { 0x1F32D, 0x1F335 },
+  { 0x1F337, 0x1F37C }, { 0x1F37E, 0x1F393 }, { 0x1F3A0, 0x1F3CA },
+  { 0x1F3CF, 0x1F3D3 }, { 0x1F3E0, 0x1F3F0 }, { 0x1F3F4, 0x1F3F4 },
+  { 0x1F3F8, 0x1F43E }, { 0x1F440, 0x1F440 }, { 0x1F442, 0x1F4FC },
+  { 0x1F4FF, 0x1F53D }, { 0x1F54B, 0x1F54E }, { 0x1F550, 0x1F567 },
+  { 0x1F57A, 0x1F57A }, { 0x1F595, 0x1F596 }, { 0x1F5A4, 0x1F5A4 },
+  { 0x1F5FB, 0x1F64F }, { 0x1F680, 0x1F6C5 }, { 0x1F6CC, 0x1F6CC },
+  { 0x1F6D0, 0x1F6D2 }, { 0x1F6D5, 0x1F6DF }, { 0x1F6EB, 0x1F6EF },
+  { 0x1F6F4, 0x1F6FF }, { 0x1F774, 0x1F77F }, { 0x1F7D9, 0x1F7FF },
+  { 0x1F80C, 0x1F80F }, { 0x1F848, 0x1F84F }, { 0x1F85A, 0x1F85F },
+  { 0x1F888, 0x1F88F }, { 0x1F8AE, 0x1F8AF }, { 0x1F8B2, 0x1F8FF },
+  { 0x1F90C, 0x1F93A }, { 0x1F93C, 0x1F945 }, { 0x1F947, 0x1F9FF },
+  { 0x1FA54, 0x1FA5F }, { 0x1FA6E, 0x1FAFF }
+};
+
+static char const* const preamble[] = {
+  "/*",
+  " * width.h",
+  " *",
+  " * Display width of every Unicode code point, as a two-level table.",
+  " *",
+  " * Generated by mkwidth.c (make -f gnu.mak width); do not edit.",
+  " * The widths are those of mk_wcwidth() in wcwidth.c, except:",
+  " *",
+  " *   - the non-spacing marks of spacing.h are width 0, as",
+  " *     XUtf8IsNonSpacing() reports them;",
+  " *   - emoji in U+1F000 to U+1FAFF that Unicode 14.0 lists as East",
+  " *     Asian Wide are width 2, where mk_wcwidth() says 1.",
+  " *",
+  " * ucs_width_index maps the high bits of a code point (ucs >> 8) to a",
+  " * row of ucs_width_block. Each row packs 256 widths, four to a byte,",
+  " * lowest code point in the low bits: 0 and 1 and 2 are widths, 3 is a",
+  " * control character (-1).",
+  " */",
+  ""
+};
+
+#define UCS_MAX 0x110000
+#define UCS_ROWS (UCS_MAX >> 8)
+
+static unsigned char l_block[UCS_ROWS][64];
+static unsigned char l_index[UCS_ROWS];
+
+/* width of one code point with the deviations from mk_wcwidth() */
+static unsigned int
+width(
+  unsigned int const i_ucs)
+{
+  int l_width;
+
+  l_width = mk_wcwidth(i_ucs);
+
+  if (0 < l_width && XUtf8IsNonSpacing(i_ucs))
+  {
+    l_width = 0;
+  }
+
+  if (1 == l_width &&
+    bisearch(i_ucs, emoji_wide,
+      sizeof(emoji_wide) / sizeof(struct interval) - 1))
+  {
+    l_width = 2;
+  }
+
+  return (0 > l_width) ? 3 : (unsigned int)l_width;
+}
+
+int
+main(void)
+{
+  unsigned char l_row[64];
+  unsigned int l_rows;
+  unsigned int l_slot;
+  unsigned int l_ucs;
+  unsigned int l_high;
+  unsigned int l_byte;
+
+  l_rows = 0;
+
+  for (l_high = 0; UCS_ROWS > l_high; l_high++)
+  {
+    memset(l_row, 0, sizeof(l_row));
+
+    for (l_ucs = 0; 256 > l_ucs; l_ucs++)
+    {
+      l_row[l_ucs >> 2] |= (unsigned char)
+        (width((l_high << 8) | l_ucs) << ((l_ucs & 3) << 1));
+    }
+
+    for (l_slot = 0; l_rows > l_slot; l_slot++)
+    {
+      if (0 == memcmp(l_block[l_slot], l_row, sizeof(l_row)))
+      {
+        break;
+      }
+    }
+
+    if (l_rows == l_slot)
+    {
+      memcpy(l_block[l_rows++], l_row, sizeof(l_row));
+    }
+
+    l_index[l_high] = (unsigned char)l_slot;
+  }
+
+  for (l_slot = 0; sizeof(preamble) / sizeof(preamble[0]) > l_slot; l_slot++)
+  {
+    printf("%s\n", preamble[l_slot]);
+  }
+
+  printf("static const unsigned char ucs_width_index[%u] = {\n", UCS_ROWS);
+
+  for (l_high = 0; UCS_ROWS > l_high; l_high++)
+  {
+    printf("%s%u%s",
+      (0 == (l_high & 15)) ? "  " : " ",
+      l_index[l_high],
+      (UCS_ROWS - 1 == l_high) ? "\n" : (15 == (l_high & 15)) ? ",\n" : ",");
+  }
+
+  printf("};\n\nstatic const unsigned char ucs_width_block[%u][64] = {\n",
+    l_rows);
+
+  for (l_slot = 0; l_rows > l_slot; l_slot++)
+  {
+    printf("  {\n");
+    for (l_byte = 0; 64 > l_byte; l_byte++)
+    {
+      printf("%s0x%02X%s",
+        (0 == (l_byte % 12)) ? "    " : " ",
+        l_block[l_slot][l_byte],
+        (63 == l_byte) ? "\n" : (11 == (l_byte % 12)) ? ",\n" : ",");
+    }
+    printf("  }%s\n", (l_rows - 1 == l_slot) ? "" : ",");
+  }
+
+  printf("};\n");
+
+  return 0;
+}
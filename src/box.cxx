@@ -76,7 +76,7 @@ Fl_Box::Fl_Box(
   unsigned int const i_len_y,
   unsigned char const* i_label) :
   Fl_Widget(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label),
-  skin_(Fl::_skin_box)
+  skin_(&Fl::_skin_box)
 {
   box_ = true;
   return;
@@ -86,8 +86,8 @@ void
 Fl_Box::draw()
 {
 
-  Fl::draw_fill(x_, y_, w_, h_, skin_.fillc, skin_.fill_fcolor,
-                skin_.fill_bcolor);
+  Fl::draw_fill(x_, y_, w_, h_, skin_->fillc, skin_->fill_fcolor,
+                skin_->fill_bcolor);
   draw_box();
   draw_label();
 
@@ -110,6 +110,15 @@ Fl_Button::setonly()
   }
 }
 
+void
+Fl_Button::shortcut(int const s)
+{
+  shortcut_ = s;
+  Fl::remove_shortcut(this, Fl::BIND_KEY);
+
+  if (s) Fl::add_shortcut(this, s);
+}
+
 void
 Fl_Button::draw()
 {
@@ -121,14 +130,14 @@ Fl_Button::draw()
 
   if (this != Fl::focus())
   {
-    l_fcolor = skin_.normal_fcolor;
-    l_bcolor = skin_.normal_bcolor;
+    l_fcolor = skin_->normal_fcolor;
+    l_bcolor = skin_->normal_bcolor;
   }
 
   else
   {
-    l_fcolor = skin_.focused_fcolor;
-    l_bcolor = skin_.focused_bcolor;
+    l_fcolor = skin_->focused_fcolor;
+    l_bcolor = skin_->focused_bcolor;
   }
 
   unsigned char ind[5];
@@ -359,6 +368,7 @@ Fl_Button::Fl_Button(
   oldval_(false)
 {
   set_flag(SHORTCUT_LABEL);
+  update_label_shortcut();
 }
 
 Fl_Radio_Button::Fl_Radio_Button(
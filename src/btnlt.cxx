@@ -83,14 +83,14 @@ Fl_Light_Button::draw()
 
   if (this != Fl::focus())
   {
-    l_fcolor = skin_.normal_fcolor;
-    l_bcolor = skin_.normal_bcolor;
+    l_fcolor = skin_->normal_fcolor;
+    l_bcolor = skin_->normal_bcolor;
   }
 
   else
   {
-    l_fcolor = skin_.focused_fcolor;
-    l_bcolor = skin_.focused_bcolor;
+    l_fcolor = skin_->focused_fcolor;
+    l_bcolor = skin_->focused_bcolor;
   }
 
   Fl::draw_fill(x_, y_, w_, h_, 0x20, l_fcolor, l_bcolor);
@@ -101,7 +101,7 @@ Fl_Light_Button::draw()
   if (value())
   {
   	Fl::draw_putc(x_+1,y_,Fl::_skin_sym.thumb,1,
-		skin_.highlight_fcolor,l_bcolor);
+		skin_->highlight_fcolor,l_bcolor);
   }
 
   return;
@@ -83,8 +83,8 @@ Fl_Menu_Button::draw()
   // int Y = y() + (h() - H) / 2;
 
   draw_label(x(), y(), X - x() + 2, h());
-  Fl::draw_putc(x_ + w_, y_, Fl::_skin_sym.down, 1, skin_.normal_fcolor,
-                skin_.normal_bcolor);
+  Fl::draw_putc(x_ + w_, y_, Fl::_skin_sym.down, 1, skin_->normal_fcolor,
+                skin_->normal_bcolor);
 
   return;
 }
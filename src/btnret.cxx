@@ -78,8 +78,8 @@ Fl_Return_Button::draw()
   if (type() == FL_HIDDEN_BUTTON) return;
 
   draw_label(x_, y_, w_, h_);
-  Fl::draw_putc(x_ + w_ - 1, y_, Fl::_skin_sym.ret, 1, skin_.normal_fcolor,
-                skin_.normal_bcolor);
+  Fl::draw_putc(x_ + w_ - 1, y_, Fl::_skin_sym.ret, 1, skin_->normal_fcolor,
+                skin_->normal_bcolor);
 
   return;
 }
@@ -77,7 +77,7 @@ void
 Fl_Choice::draw()
 {
 
-  Fl::draw_fill(x_, y_, w_, h_, 0x20, skin_.menu_fcolor, skin_.menu_bcolor);
+  Fl::draw_fill(x_, y_, w_, h_, 0x20, skin_->menu_fcolor, skin_->menu_bcolor);
 
   if (mvalue())
   {
@@ -97,7 +97,7 @@ Fl_Choice::draw()
   }
 
   Fl::draw_putc(x_ + w_ - 1, y_, Fl::_skin_sym.down, 1,
-                skin_.normal_fcolor, skin_.normal_bcolor);
+                skin_->normal_fcolor, skin_->normal_bcolor);
 
   draw_label();
 }
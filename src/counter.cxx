@@ -115,13 +115,13 @@ Fl_Counter::draw()
     ww[0],
     h_,
     0x20,
-    skin_.normal_fcolor,
-    skin_.normal_bcolor);
+    skin_->normal_fcolor,
+    skin_->normal_bcolor);
 
   unsigned char str[128];
   format(str);
   fl_draw(str, xx[0], y(), ww[0], h(), Fl_Label::FL_ALIGN_CENTER,
-          skin_.normal_fcolor, skin_.normal_bcolor, skin_.normal_fcolor);
+          skin_->normal_fcolor, skin_->normal_bcolor, skin_->normal_fcolor);
 
   if (!(damage()&FL_DAMAGE_ALL)) return;
 
@@ -132,8 +132,8 @@ Fl_Counter::draw()
       y_,
       Fl::_skin_sym.lequal,
       1,
-      skin_.normal_fcolor,
-      skin_.normal_bcolor);
+      skin_->normal_fcolor,
+      skin_->normal_bcolor);
   }
 
   Fl::draw_putc(
@@ -141,16 +141,16 @@ Fl_Counter::draw()
     y_,
     Fl::_skin_sym.left,
     1,
-    skin_.normal_fcolor,
-    skin_.normal_bcolor);
+    skin_->normal_fcolor,
+    skin_->normal_bcolor);
 
   Fl::draw_putc(
     xx[3],
     y_,
     Fl::_skin_sym.right,
     1,
-    skin_.normal_fcolor,
-    skin_.normal_bcolor);
+    skin_->normal_fcolor,
+    skin_->normal_bcolor);
 
   if (type() == FL_NORMAL_COUNTER)
   {
@@ -159,8 +159,8 @@ Fl_Counter::draw()
       y_,
       Fl::_skin_sym.gequal,
       1,
-      skin_.normal_fcolor,
-      skin_.normal_bcolor);
+      skin_->normal_fcolor,
+      skin_->normal_bcolor);
   }
 }
 
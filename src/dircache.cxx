@@ -0,0 +1,408 @@
+/*
+ dircache.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include "dircache.h"
+#include "drvsys.h"
+#include "fl.h"
+#include "filename.h"
+#include "flstring.h"
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+Fl_Dir_Cache::slot Fl_Dir_Cache::slots_[SLOTS];
+unsigned long Fl_Dir_Cache::used_ = 0;
+
+static time_t
+directory_mtime(
+  char const* i_directory)
+{
+  struct stat l_stat;
+
+  return (0 == stat(i_directory, &l_stat)) ? l_stat.st_mtime : (time_t)-1;
+}
+
+/*
+  Stores the absolute name of i_directory without a trailing separator,
+  so a listing is found again under any name and not mistaken for
+  another directory after the working directory has changed.
+*/
+static bool
+directory_key(
+  char* o_key,
+  size_t const i_size,
+  char const* i_directory)
+{
+  size_t l_len;
+
+  fl_filename_absolute(o_key, (int)i_size, i_directory);
+  l_len = strlen(o_key);
+
+  if (0 == l_len || i_size <= l_len + 1)
+  {
+    return false;
+  }
+
+  if (1 < l_len && strchr("/\\", o_key[l_len - 1]) && ':' != o_key[l_len - 2])
+  {
+    o_key[l_len - 1] = 0;
+  }
+
+  return true;
+}
+
+/*
+  Returns the listing of i_directory, which is read in the background
+  when it is not cached or has changed since; i_cb is called once it
+  is done.  Returns 0 if the directory cannot be opened.  The listing
+  belongs to the cache and may be reused for another directory by a
+  later call.
+*/
+Fl_Dir_List*
+Fl_Dir_Cache::list(
+  char const* i_directory,
+  Fl_Dir_Cache_Ready* i_cb,
+  void* i_data)
+{
+  char l_directory[FL_PATH_MAX];
+  slot* l_slot;
+  int l_index;
+
+  if (false == directory_key(l_directory, sizeof(l_directory), i_directory))
+  {
+    return 0;
+  }
+
+  update();
+  l_slot = find(l_directory);
+
+  if (l_slot && false == fresh(l_slot))
+  {
+    Fl_Dir_Cache_Ready* l_cb = l_slot->cb;
+    void* l_data = l_slot->data;
+
+    release(l_slot);
+    l_slot->cb = l_cb;
+    l_slot->data = l_data;
+  }
+
+  else if (0 == l_slot)
+  {
+    l_slot = slots_;
+
+    for (l_index = 0; SLOTS > l_index; l_index++)
+    {
+      if (0 == slots_[l_index].list || 0 == slots_[l_index].list->directory())
+      {
+        l_slot = slots_ + l_index;
+        break;
+      }
+
+      if (slots_[l_index].used < l_slot->used)
+      {
+        l_slot = slots_ + l_index;
+      }
+    }
+
+    if (l_slot->list)
+    {
+      release(l_slot);
+    }
+
+    else
+    {
+      l_slot->list = new Fl_Dir_List();
+      l_slot->watch = -1;
+    }
+  }
+
+  if (0 == l_slot->list->directory())
+  {
+    // watch first, so no change made while reading is missed
+    l_slot->watch = Fl::system_driver()->watch_directory(l_directory);
+    l_slot->mtime = (0 > l_slot->watch) ? directory_mtime(l_directory) : 0;
+    l_slot->listed = time(0);
+
+    if (false == l_slot->list->open(l_directory))
+    {
+      release(l_slot);
+      return 0;
+    }
+
+    l_slot->list->start(list_cb, l_slot);
+  }
+
+  l_slot->used = ++used_;
+
+  if (i_cb && false == l_slot->list->done())
+  {
+    l_slot->cb = i_cb;
+    l_slot->data = i_data;
+  }
+
+  return l_slot->list;
+}
+
+/*
+  Whether i_path is a directory, going by the cached listing of the
+  directory it is in.  Returns -1 when that listing is not at hand or
+  may be out of date.
+*/
+int
+Fl_Dir_Cache::isdir(
+  char const* i_path)
+{
+  char l_dir[FL_PATH_MAX];
+  char l_base_name[FL_PATH_MAX];
+  unsigned char const* l_base;
+  unsigned char const* l_sep;
+  slot* l_slot;
+  int l_index;
+  char const* l_name;
+
+  if (false == directory_key(l_dir, sizeof(l_dir), i_path))
+  {
+    return -1;
+  }
+
+  l_base = (unsigned char const*)l_dir;
+
+  while ((l_sep = Fl::system_driver()->next_dir_sep(l_base)) != 0)
+  {
+    l_base = l_sep + 1;
+  }
+
+  if (0 == *l_base)
+  {
+    return -1;
+  }
+
+  strlcpy(l_base_name, (char const*)l_base, sizeof(l_base_name));
+
+  if (l_base == (unsigned char const*)l_dir)
+  {
+    return -1;
+  }
+
+  // the root keeps its separator, as in directory_key()
+  l_sep = l_base - 1;
+
+  if (l_sep == (unsigned char const*)l_dir || ':' == l_sep[-1])
+  {
+    l_sep++;
+  }
+
+  l_dir[l_sep - (unsigned char const*)l_dir] = 0;
+
+  update();
+  l_slot = find(l_dir);
+
+  if (0 == l_slot || 0 > l_slot->watch || l_slot->changed ||
+      false == l_slot->list->done())
+  {
+    return -1;
+  }
+
+  l_index = l_slot->list->find(l_base_name);
+  l_name = l_slot->list->name(l_index);
+
+  // "." and ".." are not in the listing
+  if (0 == l_name || strcmp(l_name, l_base_name))
+  {
+    return ('.' == l_base_name[0]) ? -1 : 0;
+  }
+
+  return l_slot->list->isdir(l_index) ? 1 : 0;
+}
+
+/*
+  Forgets the callbacks waiting with i_data, which is about to go.
+*/
+void
+Fl_Dir_Cache::cancel(
+  void* i_data)
+{
+  int l_index;
+
+  for (l_index = 0; SLOTS > l_index; l_index++)
+  {
+    if (i_data == slots_[l_index].data)
+    {
+      slots_[l_index].cb = 0;
+      slots_[l_index].data = 0;
+    }
+  }
+
+  return;
+}
+
+void
+Fl_Dir_Cache::clear()
+{
+  int l_index;
+
+  for (l_index = 0; SLOTS > l_index; l_index++)
+  {
+    slot* l_slot = slots_ + l_index;
+
+    if (l_slot->list)
+    {
+      release(l_slot);
+      delete l_slot->list;
+      l_slot->list = 0;
+    }
+  }
+
+  return;
+}
+
+/*
+  Marks the listings whose directories the system driver reports as
+  changed.  The changes are collected here as well as in the wait loop,
+  so a directory changed by the caller since the last event is not
+  answered from its old listing.
+*/
+void
+Fl_Dir_Cache::update()
+{
+  int l_watches[4 * SLOTS];
+  int l_count;
+  int l_index;
+  int l_change;
+
+  for (l_index = 0; SLOTS > l_index; l_index++)
+  {
+    if (slots_[l_index].list && 0 <= slots_[l_index].watch)
+    {
+      Fl::system_driver()->poll_directories();
+      break;
+    }
+  }
+
+  l_count = Fl::system_driver()->changed_directories(
+              l_watches, sizeof(l_watches) / sizeof(l_watches[0]));
+
+  if (0 == l_count)
+  {
+    return;
+  }
+
+  for (l_index = 0; SLOTS > l_index; l_index++)
+  {
+    slot* l_slot = slots_ + l_index;
+
+    if (0 == l_slot->list || 0 > l_slot->watch)
+    {
+      continue;
+    }
+
+    for (l_change = 0; l_count > l_change; l_change++)
+    {
+      if (l_watches[l_change] == l_slot->watch)
+      {
+        break;
+      }
+    }
+
+    if (0 > l_count || l_count > l_change)
+    {
+      l_slot->changed = true;
+    }
+  }
+
+  return;
+}
+
+Fl_Dir_Cache::slot*
+Fl_Dir_Cache::find(
+  char const* i_directory)
+{
+  int l_index;
+
+  for (l_index = 0; SLOTS > l_index; l_index++)
+  {
+    Fl_Dir_List* l_list = slots_[l_index].list;
+
+    if (l_list && l_list->directory() &&
+        0 == strcmp(l_list->directory(), i_directory))
+    {
+      return slots_ + l_index;
+    }
+  }
+
+  return 0;
+}
+
+bool
+Fl_Dir_Cache::fresh(
+  slot* io_slot)
+{
+
+  if (io_slot->changed)
+  {
+    return false;
+  }
+
+  if (0 > io_slot->watch)
+  {
+    time_t l_now = time(0);
+
+    // a change in the seconds the listing was read may not show
+    if ((time_t)-1 == io_slot->mtime || io_slot->mtime + 2 > io_slot->listed ||
+        l_now - io_slot->listed >= AGE || l_now < io_slot->listed)
+    {
+      return false;
+    }
+
+    return (io_slot->mtime == directory_mtime(io_slot->list->directory()));
+  }
+
+  return true;
+}
+
+void
+Fl_Dir_Cache::release(
+  slot* io_slot)
+{
+
+  if (0 <= io_slot->watch)
+  {
+    Fl::system_driver()->unwatch_directory(io_slot->watch);
+  }
+
+  io_slot->watch = -1;
+  io_slot->changed = false;
+  io_slot->cb = 0;
+  io_slot->data = 0;
+  io_slot->list->clear();
+
+  return;
+}
+
+void
+Fl_Dir_Cache::list_cb(
+  Fl_Dir_List* i_list,
+  char const* const* i_names,
+  int const i_count,
+  void* i_data)
+{
+  slot* l_slot = reinterpret_cast<slot*>(i_data);
+
+  if (i_list->done() && l_slot->cb)
+  {
+    Fl_Dir_Cache_Ready* l_cb = l_slot->cb;
+    void* l_data = l_slot->data;
+
+    l_slot->cb = 0;
+    l_slot->data = 0;
+    (*l_cb)(i_list, l_data);
+  }
+
+  return;
+}
@@ -0,0 +1,387 @@
+/*
+ dirlist.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include "dirlist.h"
+#include "fl.h"
+#include "filename.h"
+#include "flstring.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if !defined(__WATCOMC__)
+#include <dirent.h>
+#else
+#include <direct.h>
+#endif
+
+static int
+compare_names(
+  char const* i_a,
+  char const* i_b)
+{
+  return strcmp(i_a, i_b);
+}
+
+Fl_Dir_List::Fl_Dir_List() :
+  dir_(0),
+  directory_(0),
+  names_(),
+  compare_(compare_names),
+  filter_(0),
+  cb_(0),
+  cb_data_(0),
+  index_(0),
+  scratch_(0),
+  count_(0),
+  alloc_(0),
+  nruns_(0)
+{
+  return;
+}
+
+Fl_Dir_List::~Fl_Dir_List()
+{
+
+  clear();
+  free(index_);
+  free(scratch_);
+
+  return;
+}
+
+bool
+Fl_Dir_List::open(
+  char const* i_directory)
+{
+  clear();
+
+  directory_ = strdup(i_directory);
+  dir_ = opendir(i_directory);
+
+  return (0 != dir_);
+}
+
+/*
+  Reads up to BATCH names.  Returns how many were kept; the directory
+  is closed once it has been read to the end.
+*/
+int
+Fl_Dir_List::read()
+{
+  int l_count = 0;
+  int l_read;
+
+  for (l_read = 0; dir_ && BATCH > l_read; l_read++)
+  {
+    struct dirent* l_ent = readdir((DIR*)dir_);
+
+    if (0 == l_ent)
+    {
+      stop();
+      break;
+    }
+
+    char const* l_name = l_ent->d_name;
+
+    if ('.' == l_name[0] &&
+        (0 == l_name[1] || ('.' == l_name[1] && 0 == l_name[2])))
+    {
+      continue;
+    }
+
+    if (filter_ && 0 == fl_filename_pattern_match(filter_, l_name))
+    {
+      continue;
+    }
+
+    size_t l_size = strlen(l_name) + 1;
+    char* l_copy = (char*)names_.allocate(1 + l_size);
+
+    if (0 == l_copy)
+    {
+      stop();
+      break;
+    }
+
+    // the type goes in front of the name, where isdir() finds it
+    l_copy[0] = TYPE_UNKNOWN;
+#if defined(_DIRENT_HAVE_D_TYPE)
+
+    if (DT_DIR == l_ent->d_type)
+    {
+      l_copy[0] = TYPE_DIR;
+    }
+
+    else if (DT_UNKNOWN != l_ent->d_type && DT_LNK != l_ent->d_type)
+    {
+      l_copy[0] = TYPE_FILE;
+    }
+
+#elif defined(__WATCOMC__)
+    l_copy[0] = (l_ent->d_attr & _A_SUBDIR) ? TYPE_DIR : TYPE_FILE;
+#endif
+    l_copy++;
+    memcpy(l_copy, l_name, l_size);
+
+    if (false == push(l_copy))
+    {
+      stop();
+      break;
+    }
+
+    batch_[l_count++] = l_copy;
+  }
+
+  return l_count;
+}
+
+void
+Fl_Dir_List::start(
+  Fl_Dir_List_Callback* i_cb,
+  void* i_data)
+{
+  cb_ = i_cb;
+  cb_data_ = i_data;
+
+  if (dir_ && 0 == Fl::has_idle(idle_cb, this))
+  {
+    Fl::add_idle(idle_cb, this);
+  }
+
+  return;
+}
+
+/*
+  Stops reading; the names read so far are kept.
+*/
+void
+Fl_Dir_List::stop()
+{
+
+  if (dir_)
+  {
+    closedir((DIR*)dir_);
+    dir_ = 0;
+  }
+
+  Fl::remove_idle(idle_cb, this);
+
+  return;
+}
+
+void
+Fl_Dir_List::clear()
+{
+
+  stop();
+  free(directory_);
+  directory_ = 0;
+  names_.clear();
+  count_ = 0;
+  nruns_ = 0;
+  cb_ = 0;
+  cb_data_ = 0;
+
+  return;
+}
+
+char const*
+Fl_Dir_List::name(
+  int const i_index)
+{
+  collapse();
+
+  return (0 <= i_index && count_ > i_index) ? index_[i_index] : 0;
+}
+
+/*
+  Whether the name at i_index is a directory.  Most systems say so in
+  the listing; otherwise the name is looked up once and the answer
+  kept with it.
+*/
+bool
+Fl_Dir_List::isdir(
+  int const i_index)
+{
+  char* l_name = const_cast<char*>(name(i_index));
+  char l_path[FL_PATH_MAX];
+  struct stat l_stat;
+
+  if (0 == l_name)
+  {
+    return false;
+  }
+
+  if (TYPE_UNKNOWN == l_name[-1])
+  {
+    l_name[-1] = TYPE_FILE;
+    strlcpy(l_path, directory_, sizeof(l_path));
+
+    if (l_path[0] && 0 == strchr("/\\", l_path[strlen(l_path) - 1]))
+    {
+      strlcat(l_path, "/", sizeof(l_path));
+    }
+
+    strlcat(l_path, l_name, sizeof(l_path));
+
+    if (0 == stat(l_path, &l_stat) && (l_stat.st_mode & S_IFDIR))
+    {
+      l_name[-1] = TYPE_DIR;
+    }
+  }
+
+  return (TYPE_DIR == l_name[-1]);
+}
+
+/*
+  Index of the first name that does not sort before i_prefix; with the
+  default order the names starting with i_prefix follow from there.
+*/
+int
+Fl_Dir_List::find(
+  char const* i_prefix)
+{
+  int l_low = 0;
+  int l_high = count_;
+
+  collapse();
+
+  while (l_low < l_high)
+  {
+    int l_mid = l_low + (l_high - l_low) / 2;
+
+    if (0 > (*compare_)(index_[l_mid], i_prefix))
+    {
+      l_low = l_mid + 1;
+    }
+
+    else
+    {
+      l_high = l_mid;
+    }
+  }
+
+  return l_low;
+}
+
+bool
+Fl_Dir_List::push(
+  char const* i_name)
+{
+
+  if (count_ == alloc_)
+  {
+    int l_alloc = alloc_ ? 2 * alloc_ : 1024;
+    char const** l_index =
+      (char const**)realloc(index_, l_alloc * sizeof(char const*));
+
+    if (0 == l_index)
+    {
+      return false;
+    }
+
+    index_ = l_index;
+
+    char const** l_scratch =
+      (char const**)realloc(scratch_, l_alloc * sizeof(char const*));
+
+    if (0 == l_scratch)
+    {
+      return false;
+    }
+
+    scratch_ = l_scratch;
+    alloc_ = l_alloc;
+  }
+
+  index_[count_++] = i_name;
+  runs_[nruns_++] = 1;
+
+  // run lengths stay strictly decreasing, so there are O(log n) runs
+  while (1 < nruns_ && runs_[nruns_ - 1] >= runs_[nruns_ - 2])
+  {
+    merge_top();
+  }
+
+  return true;
+}
+
+void
+Fl_Dir_List::merge_top()
+{
+  int l_right = runs_[--nruns_];
+  int l_left = runs_[nruns_ - 1];
+  char const** l_out = index_ + count_ - l_right - l_left;
+  char const** l_b = l_out + l_left;
+  char const** l_b_end = l_b + l_right;
+  int l_a = 0;
+
+  memcpy(scratch_, l_out, l_left * sizeof(char const*));
+
+  while (l_a < l_left && l_b < l_b_end)
+  {
+
+    if (0 >= (*compare_)(scratch_[l_a], *l_b))
+    {
+      *l_out++ = scratch_[l_a++];
+    }
+
+    else
+    {
+      *l_out++ = *l_b++;
+    }
+  }
+
+  while (l_a < l_left)
+  {
+    *l_out++ = scratch_[l_a++];
+  }
+
+  runs_[nruns_ - 1] = l_left + l_right;
+
+  return;
+}
+
+void
+Fl_Dir_List::collapse()
+{
+
+  while (1 < nruns_)
+  {
+    merge_top();
+  }
+
+  return;
+}
+
+/*
+  Reads a few batches per pass through the event loop, which costs far
+  more than a batch of names.  The callback may clear() or open() the
+  list, but must not delete it.
+*/
+void
+Fl_Dir_List::idle_cb(
+  void* i_data)
+{
+  Fl_Dir_List* l_list = reinterpret_cast<Fl_Dir_List*>(i_data);
+  int l_pass;
+
+  for (l_pass = 0; IDLE_BATCHES > l_pass && l_list->dir_; l_pass++)
+  {
+    int l_count = l_list->read();
+
+    if (l_list->cb_ && (l_count || l_list->done()))
+    {
+      (*l_list->cb_)(l_list, l_list->batch_, l_count, l_list->cb_data_);
+    }
+  }
+
+  return;
+}
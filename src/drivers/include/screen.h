@@ -25,8 +25,15 @@ typedef unsigned char screen_char_t;
 #endif
 
 #ifdef __CURSES__
+#if defined(__NCURSESW__)
+#define NCURSES_WIDECHAR 1
+#endif
 #include <curses.h>
+#if defined(__NCURSESW__)
+typedef cchar_t screen_block_t;
+#else
 typedef chtype screen_block_t;
+#endif
 typedef chtype screen_char_t;
 #endif
 
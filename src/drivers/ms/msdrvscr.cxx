@@ -398,6 +398,17 @@ Fl_MS_Screen_Driver::poll(Fl_Window& window)
   Fl::e_length = 1;
   Fl::e_state = 0;
 
+  if (Fl::idle)
+  {
+    count = 0;
+    GetNumberOfConsoleInputEvents(_screen_stdin, &count);
+
+    if (0 == count)
+    {
+      return;
+    }
+  }
+
   rc = ReadConsoleInputA(_screen_stdin, &record, 1, &count);
 
   if (rc && count)
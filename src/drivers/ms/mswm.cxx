@@ -100,8 +100,8 @@ mswm::handle_push(Fl_Window& window, hit_type const what) const
   blk = block_new();
   block_read_frame(blk, left, top, width, height);
   Fl::draw_frame(left, top, width, height,
-                 window.Fl_Widget::skin_.disabled_fcolor,
-                 window.Fl_Widget::skin_.normal_bcolor);
+                 window.Fl_Widget::skin_->disabled_fcolor,
+                 window.Fl_Widget::skin_->normal_bcolor);
 
   do
   {
@@ -224,8 +224,8 @@ mswm::handle_push(Fl_Window& window, hit_type const what) const
         block_write_frame(blk);
         block_read_frame(blk, left, top, width, height);
         Fl::draw_frame(left, top, width, height,
-                       window.Fl_Widget::skin_.disabled_fcolor,
-                       window.Fl_Widget::skin_.normal_bcolor);
+                       window.Fl_Widget::skin_->disabled_fcolor,
+                       window.Fl_Widget::skin_->normal_bcolor);
       }
     }
 
@@ -66,6 +66,7 @@
 //
 #include "ncdrvscr.h"
 #include "ncdrvwin.h"
+#include "drvsys.h"
 #include "keycode.h"
 #include "screen.h"
 #include "fl_skin.h"
@@ -752,7 +753,7 @@ Fl_NC_Screen_Driver::poll(Fl_Window& window)
   do
   {
 
-    nodelay(stdscr, 0);
+    nodelay(stdscr, (Fl::idle ? 1 : 0));
     int key = getch();
 
     if (ERR == key)
@@ -761,6 +762,8 @@ Fl_NC_Screen_Driver::poll(Fl_Window& window)
     }
 
     triggered = true;
+    // before the event is handled, so it sees the directories as they are
+    Fl::system_driver()->poll_directories();
 
     if (KEY_MOUSE == key)
     {
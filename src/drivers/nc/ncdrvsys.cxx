@@ -67,6 +67,12 @@
 //     License along with FLTK.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "ncdrvsys.h"
+#include <string.h>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
 
 Fl_System_Driver*
 Fl_System_Driver::newSystemDriver()
@@ -75,12 +81,153 @@ Fl_System_Driver::newSystemDriver()
 }
 
 Fl_NC_System_Driver::Fl_NC_System_Driver() :
-  Fl_System_Driver()
+  Fl_System_Driver(),
+  notify_fd_(-1),
+  changed_count_(0)
 {
   return;
 }
 
 Fl_NC_System_Driver::~Fl_NC_System_Driver()
 {
+#if defined(__linux__)
+
+  if (0 <= notify_fd_)
+  {
+    close(notify_fd_);
+  }
+
+#endif
   return;
 }
+
+int
+Fl_NC_System_Driver::watch_directory(const char* path)
+{
+#if defined(__linux__)
+
+  if (0 > notify_fd_)
+  {
+    notify_fd_ = inotify_init();
+
+    if (0 > notify_fd_)
+    {
+      return -1;
+    }
+
+    fcntl(notify_fd_, F_SETFL, O_NONBLOCK);
+    fcntl(notify_fd_, F_SETFD, FD_CLOEXEC);
+  }
+
+  return inotify_add_watch(notify_fd_, path,
+                           IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                           IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+#else
+  return -1;
+#endif
+}
+
+void
+Fl_NC_System_Driver::unwatch_directory(int watch)
+{
+#if defined(__linux__)
+
+  if (0 <= notify_fd_ && 0 <= watch)
+  {
+    inotify_rm_watch(notify_fd_, watch);
+  }
+
+#endif
+  return;
+}
+
+/*
+  Reads the events queued on the inotify descriptor without waiting
+  and keeps the watches they are for until changed_directories() asks
+  for them.
+*/
+void
+Fl_NC_System_Driver::poll_directories()
+{
+#if defined(__linux__)
+  union
+  {
+    struct inotify_event event;
+    char bytes[4096];
+  } buf;
+  ssize_t len;
+
+  if (0 > notify_fd_)
+  {
+    return;
+  }
+
+  while (0 < (len = read(notify_fd_, buf.bytes, sizeof(buf.bytes))))
+  {
+    char const* p = buf.bytes;
+
+    while (p < buf.bytes + len)
+    {
+      struct inotify_event const* event = (struct inotify_event const*)p;
+
+      if (event->mask & IN_Q_OVERFLOW)
+      {
+        changed_count_ = -1;
+      }
+
+      else if (0 <= changed_count_ && 0 == (event->mask & IN_IGNORED))
+      {
+        int i = 0;
+
+        while (i < changed_count_ && changed_[i] != event->wd)
+        {
+          i++;
+        }
+
+        if (i == CHANGED_MAX)
+        {
+          changed_count_ = -1;
+        }
+
+        else if (i == changed_count_)
+        {
+          changed_[changed_count_++] = event->wd;
+        }
+      }
+
+      p += sizeof(struct inotify_event) + event->len;
+    }
+  }
+
+#endif
+  return;
+}
+
+/*
+  Hands over the watches collected by poll_directories(); when nothing
+  has changed this does not call the system at all.
+*/
+int
+Fl_NC_System_Driver::changed_directories(int* watches, int max)
+{
+  int count = changed_count_;
+
+  if (0 == count)
+  {
+    return 0;
+  }
+
+  if (count > max)
+  {
+    count = -1;
+  }
+
+  else if (0 < count)
+  {
+    memcpy(watches, changed_, count * sizeof(changed_[0]));
+  }
+
+  changed_count_ = 0;
+
+  return count;
+}
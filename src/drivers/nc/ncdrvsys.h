@@ -76,12 +76,36 @@ class Fl_NC_System_Driver : public Fl_System_Driver
 
     virtual ~Fl_NC_System_Driver();
 
+    virtual int
+    watch_directory(const char* path);
+
+    virtual void
+    unwatch_directory(int watch);
+
+    virtual void
+    poll_directories();
+
+    virtual int
+    changed_directories(int* watches, int max);
+
     virtual int
     need_test_shortcut_extra()
     {
       return true;
     }
 
+  private:
+
+    enum
+    {
+      CHANGED_MAX = 32
+    };
+
+    int notify_fd_;
+    // -1 once more watches changed than fit
+    int changed_count_;
+    int changed_[CHANGED_MAX];
+
 };
 
 #define FL_NC_SYSTEM_DRIVER_H
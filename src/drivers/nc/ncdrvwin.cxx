@@ -112,8 +112,8 @@ Fl_NC_Window_Driver::draw_begin()
         (pWindow->y() - 1),
         (pWindow->w() + 2),
         (pWindow->h() + 2),
-        pWindow->Fl_Widget::skin_.box_fcolor,
-        pWindow->Fl_Widget::skin_.box_bcolor);
+        pWindow->Fl_Widget::skin_->box_fcolor,
+        pWindow->Fl_Widget::skin_->box_bcolor);
     }
 
     unsigned char const* label = pWindow->label();
@@ -127,8 +127,8 @@ Fl_NC_Window_Driver::draw_begin()
         (pWindow->y() - 1),
         label,
         len,
-        pWindow->Fl_Widget::skin_.normal_fcolor,
-        pWindow->Fl_Widget::skin_.normal_bcolor);
+        pWindow->Fl_Widget::skin_->normal_fcolor,
+        pWindow->Fl_Widget::skin_->normal_bcolor);
     }
   }
 
@@ -231,29 +231,72 @@ Fl_NC_Window_Driver::erase_menu()
 }
 
 void
-Fl_NC_Window_Driver::show_menu()
+Fl_NC_Window_Driver::menu_area(int& o_x, int& o_y, int& o_w, int& o_h) const
 {
 
-  Fl_Window_Driver::show_menu();
-
-  int x = pWindow->x();
-  int y = pWindow->y();
-  int w = pWindow->w();
-  int h = pWindow->h();
+  o_x = pWindow->x();
+  o_y = pWindow->y();
+  o_w = pWindow->w();
+  o_h = pWindow->h();
 
   if (pWindow->get_border())
   {
-    x--;
-    y--;
-    w += 2;
-    h += 2;
+    o_x--;
+    o_y--;
+    o_w += 2;
+    o_h += 2;
   }
 
+  return;
+}
+
+void
+Fl_NC_Window_Driver::show_menu()
+{
+
+  Fl_Window_Driver::show_menu();
+
+  int x, y, w, h;
+
+  menu_area(x, y, w, h);
   block_read(block_, x, y, w, h);
 
   return;
 }
 
+bool
+Fl_NC_Window_Driver::save_menu(struct block* o_cells)
+{
+  int x, y, w, h;
+
+  menu_area(x, y, w, h);
+  block_read(o_cells, x, y, w, h);
+
+  return (0 != (*o_cells).m_data);
+}
+
+bool
+Fl_NC_Window_Driver::restore_menu(struct block const* i_cells)
+{
+  int x, y, w, h;
+
+  menu_area(x, y, w, h);
+
+  if ((unsigned int)w != (*i_cells).m_len_x ||
+      (unsigned int)h != (*i_cells).m_len_y || 0 == (*i_cells).m_data)
+  {
+    return false;
+  }
+
+  // the cells do not depend on where the window was when they were read
+  struct block moved = *i_cells;
+  moved.m_pos_x = x;
+  moved.m_pos_y = y;
+  block_write(&moved);
+
+  return true;
+}
+
 void
 Fl_NC_Window_Driver::resize(int X, int Y, int W, int H)
 {
@@ -284,6 +327,13 @@ Fl_NC_Window_Driver::scrollto(
 {
   struct block* blk;
 
+  // cells of windows stacked above must not be moved
+  if (false == Fl::gr().clip_owns(X, Y, W, H) ||
+      false == Fl::gr().clip_owns(dx, dy, W, H))
+  {
+    return 1;
+  }
+
   blk = block_new();
   block_read(
     blk,
@@ -7,14 +7,28 @@
  and related or neighboring rights to FDOSTUI Library. This work is published
  from: United States.
 */
+#if defined(__NCURSESW__)
+#define _XOPEN_SOURCE 600
+#endif
 #include "screen.h"
 #include <stdio.h>
+#if defined(__NCURSESW__)
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#endif
 
 short int                               mouse_initialized = 0;
 int                                     _video_has_color = 1;
 unsigned int                            _video_cols = 80;
 unsigned int                            _video_rows = 25;
 
+#if defined(__NCURSESW__)
+static cchar_t*                         _row_cells = 0;
+static unsigned int                     _row_alloc = 0;
+#endif
+
 struct screen_pair_map
 {
   enum foreground                       m_fcolor;
@@ -172,6 +186,10 @@ screen_init()
 
   l_exit = 0;
 
+#if defined(__NCURSESW__)
+  setlocale(LC_CTYPE, "");
+#endif
+
   initscr(); /* aborts on error */
 
   _video_cols = COLS;
@@ -218,6 +236,12 @@ screen_deinit()
 
   endwin();
 
+#if defined(__NCURSESW__)
+  free(_row_cells);
+  _row_cells = 0;
+  _row_alloc = 0;
+#endif
+
   return;
 }
 
@@ -414,6 +438,8 @@ screen_putvc(
   return;
 }
 
+#if !defined(__NCURSESW__)
+
 extern void
 screen_puts(
   int const                           i_col,
@@ -501,6 +527,199 @@ screen_puts(
   return;
 }
 
+#else /* __NCURSESW__ */
+
+static cchar_t*
+screen_row_cells(
+  unsigned int const                  i_count)
+{
+  void*                               l_cells;
+
+  if (_row_alloc < i_count)
+  {
+    l_cells = realloc(_row_cells, i_count * sizeof(cchar_t));
+
+    if (0 == l_cells)
+    {
+      return 0;
+    }
+
+    _row_cells = (cchar_t*)l_cells;
+    _row_alloc = i_count;
+  }
+
+  return _row_cells;
+}
+
+/* number of columns taken by a cell, 0 for the terminating cell */
+static int
+screen_cell_width(
+  cchar_t const*                      i_cell,
+  attr_t*                             o_attr,
+  short*                              o_pair)
+{
+  wchar_t                             l_wch[CCHARW_MAX + 1];
+  int                                 l_width;
+
+  l_wch[0] = 0;
+  getcchar(i_cell, l_wch, o_attr, o_pair, 0);
+
+  if (0 == l_wch[0])
+  {
+    return 0;
+  }
+
+  l_width = wcwidth(l_wch[0]);
+
+  return (1 < l_width) ? 2 : 1;
+}
+
+extern void
+screen_puts(
+  int const                           i_col,
+  int const                           i_row,
+  unsigned char const*                i_string,
+  unsigned int const                  i_length,
+  enum foreground const               i_fcolor,
+  enum background const               i_bcolor)
+{
+  cchar_t*                            l_cells;
+  int                                 l_col;
+  unsigned int                        l_count;
+  unsigned int                        l_left;
+  size_t                              l_len;
+  short                               l_pair;
+  unsigned char const*                l_ptr;
+  mbstate_t                           l_state;
+  wchar_t                             l_wch[CCHARW_MAX + 1];
+  int                                 l_width;
+
+  do
+  {
+
+    if (0 == i_length)
+    {
+      break;
+    }
+
+    if (0 > i_row || _video_rows <= i_row)
+    {
+      break;
+    }
+
+    if ((int)_video_cols <= i_col)
+    {
+      break;
+    }
+
+    l_cells = screen_row_cells(_video_cols);
+
+    if (0 == l_cells)
+    {
+      break;
+    }
+
+    l_pair = 0;
+
+    if (_video_has_color)
+    {
+      l_pair = screen_map_get_pair(i_fcolor, i_bcolor);
+    }
+
+    memset(&l_state, 0, sizeof(l_state));
+
+    l_col = i_col;
+    l_count = 0;
+    l_left = i_length;
+    l_ptr = i_string;
+
+    while (l_left && (int)_video_cols > l_col)
+    {
+      l_len = mbrtowc(&l_wch[0], (char const*)l_ptr, l_left, &l_state);
+
+      if ((size_t)-1 == l_len || (size_t)-2 == l_len)
+      {
+        /* not UTF-8 (or the locale's encoding), show the byte as Latin-1 */
+        l_wch[0] = *l_ptr;
+        l_len = 1;
+        memset(&l_state, 0, sizeof(l_state));
+      }
+
+      else if (0 == l_len)
+      {
+        l_len = 1;
+      }
+
+      l_ptr += l_len;
+      l_left -= l_len;
+
+      l_width = wcwidth(l_wch[0]);
+
+      if (0 > l_width)
+      {
+        l_wch[0] = L' ';
+        l_width = 1;
+      }
+
+      if (0 == l_width)
+      {
+        /* combining mark, attach it to the previous cell */
+        if (l_count)
+        {
+          attr_t l_attr;
+          short l_cpair;
+          wchar_t l_base[CCHARW_MAX + 1];
+          size_t l_slot;
+
+          getcchar(&l_cells[l_count - 1], l_base, &l_attr, &l_cpair, 0);
+          l_slot = wcslen(l_base);
+
+          if (CCHARW_MAX > l_slot)
+          {
+            l_base[l_slot++] = l_wch[0];
+            l_base[l_slot] = 0;
+            setcchar(&l_cells[l_count - 1], l_base, l_attr, l_cpair, 0);
+          }
+        }
+
+        continue;
+      }
+
+      l_wch[1] = 0;
+
+      if (0 > l_col || (int)_video_cols < l_col + l_width)
+      {
+        /* the part of a wide character that is on screen is blanked */
+        l_wch[0] = L' ';
+
+        for (; l_width; l_width--, l_col++)
+        {
+          if (0 <= l_col && (int)_video_cols > l_col)
+          {
+            setcchar(&l_cells[l_count++], l_wch, A_NORMAL, l_pair, 0);
+          }
+        }
+
+        continue;
+      }
+
+      setcchar(&l_cells[l_count++], l_wch, A_NORMAL, l_pair, 0);
+      l_col += l_width;
+    }
+
+    if (l_count)
+    {
+      mvadd_wchnstr(i_row, ((0 > i_col) ? 0 : i_col), l_cells, l_count);
+    }
+
+  }
+  while (0);
+
+  return;
+}
+
+#endif /* __NCURSESW__ */
+
 extern void
 screen_set_color(
   int const                           i_col,
@@ -566,6 +785,8 @@ screen_set_color(
   return;
 }
 
+#if !defined(__NCURSESW__)
+
 extern screen_block_t
 screen_getc(
   int const                           i_col,
@@ -708,6 +929,254 @@ screen_writev(
   return l_next;
 }
 
+#else /* __NCURSESW__ */
+
+/*
+ Reads the cells of i_columns screen columns into o_block, one
+ cchar_t per character. A wide character takes one cell for its two
+ columns, so the unused tail is filled with terminating (zero) cells.
+ Wide characters cut by either edge are replaced by blanks so that a
+ later screen_write puts back exactly the columns that were read.
+*/
+static screen_block_t*
+screen_read_row(
+  screen_block_t*                     o_block,
+  unsigned int const                  i_columns,
+  int const                           i_col,
+  int const                           i_row)
+{
+  attr_t                              l_attr;
+  cchar_t const*                      l_cell;
+  cchar_t*                            l_cells;
+  int                                 l_edge;
+  int                                 l_end;
+  unsigned int                        l_out;
+  short                               l_pair;
+  int                                 l_pos;
+  wchar_t                             l_space[2];
+  int                                 l_width;
+
+  l_out = 0;
+  l_cells = screen_row_cells(_video_cols + 1);
+
+  if (l_cells)
+  {
+    memset(l_cells, 0, (_video_cols + 1) * sizeof(cchar_t));
+    mvin_wchnstr(i_row, 0, l_cells, _video_cols);
+
+    l_space[0] = L' ';
+    l_space[1] = 0;
+    l_end = i_col + i_columns;
+    l_pos = 0;
+
+    for (l_cell = l_cells; l_end > l_pos; l_cell++)
+    {
+      l_width = screen_cell_width(l_cell, &l_attr, &l_pair);
+
+      if (0 == l_width)
+      {
+        break;
+      }
+
+      if (i_col < l_pos + l_width)
+      {
+        if (i_col <= l_pos && l_end >= l_pos + l_width)
+        {
+          o_block[l_out++] = *l_cell;
+        }
+
+        else
+        {
+          for (l_edge = l_pos; l_pos + l_width > l_edge; l_edge++)
+          {
+            if (i_col <= l_edge && l_end > l_edge)
+            {
+              setcchar(&o_block[l_out++], l_space, l_attr, l_pair, 0);
+            }
+          }
+        }
+      }
+
+      l_pos += l_width;
+    }
+  }
+
+  memset(&o_block[l_out], 0, (i_columns - l_out) * sizeof(cchar_t));
+
+  return o_block + i_columns;
+}
+
+extern screen_block_t
+screen_getc(
+  int const                           i_col,
+  int const                           i_row)
+{
+  screen_block_t                      l_info;
+
+  memset(&l_info, 0, sizeof(l_info));
+
+  if (0 <= i_row && _video_rows > i_row &&
+      0 <= i_col && _video_cols > i_col)
+  {
+    screen_read_row(&l_info, 1, i_col, i_row);
+  }
+
+  return l_info;
+}
+
+extern screen_block_t*
+screen_read(
+  screen_block_t*                     o_block,
+  unsigned int const                  i_columns,
+  int const                           i_col,
+  int const                           i_row)
+{
+  unsigned int                        l_left;
+  int                                 l_col;
+  screen_block_t*                     l_next;
+
+  l_col = i_col;
+  l_left = i_columns;
+  l_next = o_block;
+
+  if (0 <= i_row && _video_rows > i_row)
+  {
+    while (l_left && 0 > l_col)
+    {
+      l_col++;
+      l_left--;
+    }
+
+    if (_video_cols <= l_col)
+    {
+      l_left = 0;
+    }
+
+    else if (_video_cols < l_col + l_left)
+    {
+      l_left = _video_cols - l_col;
+    }
+
+    if (l_left)
+    {
+      l_next = screen_read_row(l_next, l_left, l_col, i_row);
+    }
+  }
+
+  return l_next;
+}
+
+extern screen_block_t*
+screen_readv(
+  screen_block_t*                     o_block,
+  unsigned int const                  i_rows,
+  int const                           i_col,
+  int const                           i_row)
+{
+  unsigned int                        l_left;
+  screen_block_t*                     l_next;
+  int                                 l_row;
+
+  l_row = i_row;
+  l_left = i_rows;
+  l_next = o_block;
+
+  if (0 <= i_col && _video_cols > i_col)
+  {
+    while (l_left && 0 > l_row)
+    {
+      l_row++;
+      l_left--;
+    }
+
+    for (; l_left && _video_rows > l_row; l_row++, l_left--)
+    {
+      l_next = screen_read_row(l_next, 1, i_col, l_row);
+    }
+
+  }
+
+  return l_next;
+}
+
+extern screen_block_t const*
+screen_write(
+  int const                           i_col,
+  int const                           i_row,
+  screen_block_t const*               i_block,
+  unsigned int const                  i_columns)
+{
+  unsigned int                        l_left;
+  int                                 l_col;
+  screen_block_t const*               l_next;
+
+  l_col = i_col;
+  l_left = i_columns;
+  l_next = i_block;
+
+  if (0 <= i_row && _video_rows > i_row)
+  {
+    while (l_left && 0 > l_col)
+    {
+      l_col++;
+      l_left--;
+    }
+
+    if (_video_cols <= l_col)
+    {
+      l_left = 0;
+    }
+
+    else if (_video_cols < l_col + l_left)
+    {
+      l_left = _video_cols - l_col;
+    }
+
+    if (l_left)
+    {
+      mvadd_wchnstr(i_row, l_col, l_next, l_left);
+      l_next += l_left;
+    }
+  }
+
+  return l_next;
+}
+
+extern screen_block_t const*
+screen_writev(
+  int const                           i_col,
+  int const                           i_row,
+  screen_block_t const*               i_block,
+  unsigned int const                  i_rows)
+{
+  unsigned int                        l_left;
+  screen_block_t const*               l_next;
+  int                                 l_row;
+
+  l_row = i_row;
+  l_left = i_rows;
+  l_next = i_block;
+
+  if (0 <= i_col && _video_cols > i_col)
+  {
+    while (l_left && 0 > l_row)
+    {
+      l_row++;
+      l_left--;
+    }
+
+    for (; l_left && _video_rows > l_row; l_row++, l_left--)
+    {
+      mvadd_wchnstr(l_row, i_col, l_next++, 1);
+    }
+
+  }
+
+  return l_next;
+}
+
+#endif /* __NCURSESW__ */
+
 extern void
 screen_push(
   int const                           i_copy)
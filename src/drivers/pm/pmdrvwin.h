@@ -98,6 +98,10 @@ class Fl_PM_Window_Driver : public Fl_Window_Driver
 
     virtual void show_menu();
 
+    virtual bool save_menu(struct block* o_cells);
+
+    virtual bool restore_menu(struct block const* i_cells);
+
     virtual void resize(int X, int Y, int W, int H);
 
     virtual int scrollto(
@@ -121,6 +125,8 @@ class Fl_PM_Window_Driver : public Fl_Window_Driver
   protected:
 
     struct block* block_;
+
+    void menu_area(int& o_x, int& o_y, int& o_w, int& o_h) const;
 };
 
 #define FL_PM_WINDOW_DRIVER_H
@@ -66,7 +66,10 @@
 #include "drvscr.h"
 #include "drvsys.h"
 #include "drvwin.h"
+#include "dircache.h"
 #include "fl.h"
+#include "winmap.h"
+#include "winmenu.h"
 
 class fl_cleanup
 {
@@ -93,6 +96,10 @@ fl_cleanup::fl_cleanup()
 fl_cleanup::~fl_cleanup()
 {
 
+  Fl_Dir_Cache::clear();
+  Fl_Menu_Window::clear_cache();
+  Fl_Window_Map::clear();
+
   Fl_System_Driver* sys = Fl::system_driver();
   delete sys;
 
@@ -0,0 +1,1068 @@
+/*
+ fileview.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(__DOS__) && !defined(__NT__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "fileview.h"
+#include "fl.h"
+#include "fl_clip.h"
+#include "fl_draw.h"
+
+#if defined(__DOS__) || defined(__NT__)
+#define WINDOW_SIZE (32U * 1024U)
+#else
+#define WINDOW_SIZE (1024U * 1024U)
+#endif
+
+#if defined(__NT__)
+#define FILE_SEEK(f, o, w) _fseeki64((f), (o), (w))
+#define FILE_TELL(f) _ftelli64(f)
+#elif defined(__DOS__)
+#define FILE_SEEK(f, o, w) fseek((f), (long)(o), (w))
+#define FILE_TELL(f) ftell(f)
+#endif
+
+Fl_File_View::Fl_File_View(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  unsigned char const* i_label) :
+  Fl_Group(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label),
+#if defined(__DOS__) || defined(__NT__)
+  fp_(0),
+#else
+  fd_(-1),
+#endif
+  size_(0),
+  win_(0),
+  win_off_(0),
+  win_len_(0),
+  win_max_(WINDOW_SIZE),
+  marks_(0),
+  nmarks_(0),
+  amarks_(0),
+  idx_off_(0),
+  nl_(0),
+  last_start_(0),
+  longest_(0),
+  top_(0),
+  hoff_(0),
+  goto_(-1),
+  needle_len_(0),
+  search_off_(0),
+  search_line_(0),
+  searching_(false),
+  found_(-1),
+  row_(0),
+  row_len_(0)
+{
+
+  vscroll_ = new Fl_Scrollbar(0, 0, 1, 1);
+  vscroll_->callback((Fl_Callback*)v_scrollbar_cb, this);
+
+  hscroll_ = new Fl_Scrollbar(0, 0, 1, 1);
+  hscroll_->callback((Fl_Callback*)h_scrollbar_cb, this);
+  hscroll_->type(FL_HORIZONTAL);
+
+  end();
+
+  resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  return;
+}
+
+Fl_File_View::~Fl_File_View()
+{
+  close();
+  free(row_);
+}
+
+int
+Fl_File_View::load(
+  char const* i_path)
+{
+  int rc = -1;
+
+  close();
+
+  do
+  {
+
+#if defined(__DOS__) || defined(__NT__)
+    fp_ = fopen(i_path, "rb");
+
+    if (0 == fp_)
+    {
+      break;
+    }
+
+    if (FILE_SEEK(fp_, 0, SEEK_END))
+    {
+      break;
+    }
+
+    size_ = (fl_off_t)FILE_TELL(fp_);
+
+    // on DOS a file of 2 GB or more does not fit a long
+    if (0 > size_)
+    {
+      size_ = 0;
+      errno = EFBIG;
+      break;
+    }
+
+    win_ = (unsigned char*)malloc(win_max_);
+
+    if (0 == win_)
+    {
+      errno = ENOMEM;
+      break;
+    }
+
+#else
+    struct stat st;
+
+    fd_ = open(i_path, O_RDONLY);
+
+    if (-1 == fd_)
+    {
+      break;
+    }
+
+    if (fstat(fd_, &st))
+    {
+      break;
+    }
+
+    size_ = (fl_off_t)st.st_size;
+
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (0 < page && (size_t)page * 2 > win_max_)
+    {
+      win_max_ = (size_t)page * 2;
+    }
+
+#endif
+
+    amarks_ = 1024;
+    marks_ = (fl_off_t*)malloc(amarks_ * sizeof(fl_off_t));
+
+    if (0 == marks_)
+    {
+      errno = ENOMEM;
+      break;
+    }
+
+    marks_[0] = 0;
+    nmarks_ = 1;
+
+    rc = 0;
+
+  }
+  while (0);
+
+  if (rc)
+  {
+    int err = errno;
+    close();
+    errno = err;
+    return rc;
+  }
+
+  if (size_)
+  {
+    Fl::add_idle(idle_cb, this);
+  }
+
+  redraw();
+
+  return rc;
+}
+
+void
+Fl_File_View::close()
+{
+
+  Fl::remove_idle(idle_cb, this);
+
+  unmap();
+
+#if defined(__DOS__) || defined(__NT__)
+
+  if (fp_)
+  {
+    fclose(fp_);
+    fp_ = 0;
+  }
+
+  free(win_);
+  win_ = 0;
+#else
+
+  if (-1 != fd_)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+#endif
+
+  free(marks_);
+  marks_ = 0;
+  nmarks_ = 0;
+  amarks_ = 0;
+
+  size_ = 0;
+  idx_off_ = 0;
+  nl_ = 0;
+  last_start_ = 0;
+  longest_ = 0;
+  top_ = 0;
+  hoff_ = 0;
+  goto_ = -1;
+  needle_len_ = 0;
+  searching_ = false;
+  found_ = -1;
+
+  redraw();
+
+  return;
+}
+
+void
+Fl_File_View::unmap()
+{
+#if !defined(__DOS__) && !defined(__NT__)
+
+  if (win_)
+  {
+    munmap(win_, win_len_);
+    win_ = 0;
+  }
+
+#endif
+  win_off_ = 0;
+  win_len_ = 0;
+
+  return;
+}
+
+// Returns a pointer to the byte at i_offset with at least i_need bytes
+// behind it (fewer only at the end of the file), or 0 past the end of
+// the file or on a read error.
+unsigned char const*
+Fl_File_View::fetch(
+  fl_off_t const i_offset,
+  size_t const i_need,
+  size_t* o_avail)
+{
+  fl_off_t end;
+
+  if (0 > i_offset || i_offset >= size_)
+  {
+    return 0;
+  }
+
+  end = i_offset + (fl_off_t)i_need;
+
+  if (end > size_)
+  {
+    end = size_;
+  }
+
+  if (0 == win_len_ || i_offset < win_off_ ||
+      end > win_off_ + (fl_off_t)win_len_)
+  {
+    fl_off_t base = i_offset;
+    size_t len;
+
+    unmap();
+
+#if defined(__DOS__) || defined(__NT__)
+
+    len = win_max_;
+
+    if ((fl_off_t)len > size_ - base)
+    {
+      len = (size_t)(size_ - base);
+    }
+
+    if (FILE_SEEK(fp_, base, SEEK_SET) ||
+        len != fread(win_, 1, len, fp_))
+    {
+      return 0;
+    }
+
+#else
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (0 < page)
+    {
+      base -= (i_offset % page);
+    }
+
+    len = win_max_;
+
+    if ((fl_off_t)len > size_ - base)
+    {
+      len = (size_t)(size_ - base);
+    }
+
+    void* map = mmap(0, len, PROT_READ, MAP_PRIVATE, fd_, (off_t)base);
+
+    if (MAP_FAILED == map)
+    {
+      return 0;
+    }
+
+    win_ = (unsigned char*)map;
+#endif
+
+    win_off_ = base;
+    win_len_ = len;
+  }
+
+  *o_avail = (size_t)(win_off_ + (fl_off_t)win_len_ - i_offset);
+
+  return win_ + (i_offset - win_off_);
+}
+
+long
+Fl_File_View::lines() const
+{
+  long count = nl_;
+
+  if (indexed() && last_start_ < size_)
+  {
+    count++;
+  }
+
+  return count;
+}
+
+// Lines up to and including nl_ have a known start. Seek from the
+// closest index mark and skip the remaining lines.
+fl_off_t
+Fl_File_View::line_offset(
+  long const i_line)
+{
+  long mark = i_line / MARK_STRIDE;
+  long skip = i_line - (mark * MARK_STRIDE);
+  fl_off_t offset;
+
+  if (i_line >= nl_)
+  {
+    return last_start_;
+  }
+
+  offset = marks_[mark];
+
+  while (skip)
+  {
+    size_t avail;
+    unsigned char const* p = fetch(offset, 1, &avail);
+
+    if (0 == p)
+    {
+      break;
+    }
+
+    unsigned char const* end = p + avail;
+    unsigned char const* s = p;
+
+    while (skip && s < end)
+    {
+      unsigned char const* q =
+        (unsigned char const*)memchr(s, '\n', (size_t)(end - s));
+
+      if (0 == q)
+      {
+        s = end;
+        break;
+      }
+
+      s = q + 1;
+      skip--;
+    }
+
+    offset += (fl_off_t)(s - p);
+  }
+
+  return offset;
+}
+
+void
+Fl_File_View::index_slice()
+{
+  size_t budget = SLICE;
+
+  while (budget && idx_off_ < size_)
+  {
+    size_t avail;
+    unsigned char const* p = fetch(idx_off_, 1, &avail);
+
+    if (0 == p)
+    {
+      // unreadable tail: stop the file here
+      size_ = idx_off_;
+      break;
+    }
+
+    if (avail > budget)
+    {
+      avail = budget;
+    }
+
+    unsigned char const* end = p + avail;
+    unsigned char const* s = p;
+
+    while (s < end)
+    {
+      unsigned char const* q =
+        (unsigned char const*)memchr(s, '\n', (size_t)(end - s));
+
+      if (0 == q)
+      {
+        break;
+      }
+
+      fl_off_t next = idx_off_ + (fl_off_t)(q - p) + 1;
+
+      if (next - 1 - last_start_ > longest_)
+      {
+        longest_ = next - 1 - last_start_;
+      }
+
+      nl_++;
+      last_start_ = next;
+
+      if (0 == (nl_ % MARK_STRIDE))
+      {
+        if (nmarks_ == amarks_)
+        {
+          fl_off_t* marks = (fl_off_t*)realloc(marks_,
+                                         2 * amarks_ * sizeof(fl_off_t));
+
+          if (0 == marks)
+          {
+            nl_--;
+            size_ = next - 1;
+            return;
+          }
+
+          marks_ = marks;
+          amarks_ *= 2;
+        }
+
+        marks_[nmarks_++] = next;
+      }
+
+      s = q + 1;
+    }
+
+    idx_off_ += (fl_off_t)avail;
+    budget -= avail;
+  }
+
+  if (indexed() && size_ - last_start_ > longest_)
+  {
+    longest_ = size_ - last_start_;
+  }
+
+  return;
+}
+
+void
+Fl_File_View::search_start(
+  fl_off_t const i_offset,
+  long const i_line)
+{
+
+  search_off_ = i_offset;
+  search_line_ = i_line;
+  searching_ = (0 != needle_len_);
+
+  if (searching_ && 0 == Fl::has_idle(idle_cb, this))
+  {
+    Fl::add_idle(idle_cb, this);
+  }
+
+  return;
+}
+
+void
+Fl_File_View::search(
+  unsigned char const* i_text)
+{
+  size_t len = strlen((char const*)i_text);
+
+  if (len > SEARCH_MAX)
+  {
+    len = SEARCH_MAX;
+  }
+
+  memcpy(needle_, i_text, len);
+  needle_len_ = len;
+
+  if (0 <= found_)
+  {
+    found_ = -1;
+    damage(FL_DAMAGE_EXPOSE);
+  }
+
+  search_start(line_offset(top_), top_);
+
+  return;
+}
+
+void
+Fl_File_View::search_next()
+{
+
+  if (searching_)
+  {
+    return;
+  }
+
+  if (0 > found_)
+  {
+    search_start(line_offset(top_), top_);
+    return;
+  }
+
+  // continue from the match; hits on the same line are skipped
+  search_start(search_off_, search_line_);
+
+  return;
+}
+
+void
+Fl_File_View::search_cancel()
+{
+  searching_ = false;
+}
+
+void
+Fl_File_View::search_slice()
+{
+  size_t budget = SLICE;
+  long skip = found_;
+
+  while (budget)
+  {
+    size_t avail;
+    unsigned char const* p;
+
+    if (search_off_ + (fl_off_t)needle_len_ > size_)
+    {
+      searching_ = false;
+      found_ = -1;
+      damage(FL_DAMAGE_EXPOSE);
+      do_callback();
+      return;
+    }
+
+    p = fetch(search_off_, needle_len_, &avail);
+
+    if (0 == p || avail < needle_len_)
+    {
+      searching_ = false;
+      found_ = -1;
+      do_callback();
+      return;
+    }
+
+    size_t n = avail - needle_len_ + 1;
+
+    if (n > budget)
+    {
+      n = budget;
+    }
+
+    for (size_t i = 0; n > i; i++)
+    {
+      if (needle_[0] == p[i] && search_line_ != skip &&
+          0 == memcmp(p + i, needle_, needle_len_))
+      {
+        search_off_ += (fl_off_t)i;
+        searching_ = false;
+        found_ = search_line_;
+        scroll_to(found_ - (long)(text_area.h / 2));
+        damage(FL_DAMAGE_EXPOSE);
+        do_callback();
+        return;
+      }
+
+      if ('\n' == p[i])
+      {
+        search_line_++;
+      }
+    }
+
+    search_off_ += (fl_off_t)n;
+    budget -= n;
+  }
+
+  return;
+}
+
+long
+Fl_File_View::max_top() const
+{
+  long top = lines() - (long)text_area.h;
+
+  if (0 > top)
+  {
+    top = 0;
+  }
+
+  return top;
+}
+
+// Lines past the indexed part of the file are reached once the
+// index catches up.
+void
+Fl_File_View::scroll_to(
+  long const i_line)
+{
+  long line = i_line;
+
+  if (0 > line)
+  {
+    line = 0;
+  }
+
+  if (line > max_top())
+  {
+    if (false == indexed())
+    {
+      goto_ = line;
+      line = max_top();
+    }
+
+    else
+    {
+      goto_ = -1;
+      line = max_top();
+    }
+  }
+
+  else
+  {
+    goto_ = -1;
+  }
+
+  if (line != top_)
+  {
+    top_ = line;
+    damage(FL_DAMAGE_EXPOSE);
+  }
+
+  return;
+}
+
+void
+Fl_File_View::top_line(
+  long const i_line)
+{
+  scroll_to(i_line - 1);
+}
+
+void
+Fl_File_View::idle_cb(
+  void* i_data)
+{
+  Fl_File_View* view = (Fl_File_View*)i_data;
+  long had = view->lines();
+
+  if (false == view->indexed())
+  {
+    view->index_slice();
+  }
+
+  if (view->searching_)
+  {
+    view->search_slice();
+  }
+
+  if (had != view->lines())
+  {
+    if (0 <= view->goto_)
+    {
+      view->scroll_to(view->goto_);
+    }
+
+    if (view->top_ + (long)view->text_area.h > had)
+    {
+      view->damage(FL_DAMAGE_EXPOSE);
+    }
+
+    else
+    {
+      view->update_scrollbars();
+    }
+  }
+
+  if (false == view->busy())
+  {
+    Fl::remove_idle(idle_cb, view);
+  }
+
+  return;
+}
+
+void
+Fl_File_View::update_scrollbars()
+{
+  long total = lines();
+  long width = (long)longest_;
+
+  if (INT_MAX < total)
+  {
+    total = INT_MAX;
+  }
+
+  if (INT_MAX < width)
+  {
+    width = INT_MAX;
+  }
+
+  vscroll_->value((int)top_, (int)text_area.h, 0, (int)total);
+  vscroll_->linesize(1);
+  hscroll_->value(hoff_, (int)text_area.w, 0, (int)width);
+  hscroll_->linesize(1);
+
+  return;
+}
+
+void
+Fl_File_View::v_scrollbar_cb(
+  Fl_Scrollbar* i_bar,
+  Fl_File_View* i_view)
+{
+  i_view->scroll_to(i_bar->value());
+}
+
+void
+Fl_File_View::h_scrollbar_cb(
+  Fl_Scrollbar* i_bar,
+  Fl_File_View* i_view)
+{
+
+  if (i_bar->value() != i_view->hoff_)
+  {
+    i_view->hoff_ = i_bar->value();
+    i_view->damage(FL_DAMAGE_EXPOSE);
+  }
+
+  return;
+}
+
+void
+Fl_File_View::resize(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y)
+{
+
+  Fl_Widget::resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  text_area.x = i_pos_x;
+  text_area.y = i_pos_y;
+  text_area.w = (i_len_x > 1) ? i_len_x - 1 : 0;
+  text_area.h = (i_len_y > 1) ? i_len_y - 1 : 0;
+
+  vscroll_->resize(i_pos_x + text_area.w, i_pos_y, 1, text_area.h);
+  hscroll_->resize(i_pos_x, i_pos_y + text_area.h, text_area.w, 1);
+
+  if (row_len_ < text_area.w)
+  {
+    unsigned char* row = (unsigned char*)realloc(row_, text_area.w);
+
+    if (row)
+    {
+      row_ = row;
+      row_len_ = text_area.w;
+    }
+  }
+
+  if (top_ > max_top())
+  {
+    top_ = max_top();
+  }
+
+  return;
+}
+
+// Draws the line starting at i_offset and returns the offset of the
+// line that follows it. Tabs are expanded, carriage returns dropped
+// and other control characters shown as '.'.
+fl_off_t
+Fl_File_View::draw_row(
+  fl_off_t const i_offset,
+  int const i_pos_y,
+  enum Fl::foreground const i_fcolor,
+  enum Fl::background const i_bcolor)
+{
+  unsigned int const cols = (row_len_ < text_area.w) ? row_len_ : text_area.w;
+  fl_off_t offset = i_offset;
+  long col = 0;
+  long const left = hoff_;
+  long const right = left + (long)cols;
+
+  memset(row_, ' ', cols);
+
+  while (1)
+  {
+    size_t avail;
+    unsigned char const* p = fetch(offset, 1, &avail);
+
+    if (0 == p)
+    {
+      break;
+    }
+
+    if (col >= right)
+    {
+      // nothing more to show, skip to the next line
+      unsigned char const* q = (unsigned char const*)memchr(p, '\n', avail);
+
+      if (q)
+      {
+        offset += (fl_off_t)(q - p) + 1;
+        break;
+      }
+
+      offset += (fl_off_t)avail;
+      continue;
+    }
+
+    size_t i = 0;
+
+    for (; avail > i && col < right; i++)
+    {
+      unsigned char c = p[i];
+
+      if ('\n' == c)
+      {
+        break;
+      }
+
+      if ('\r' == c)
+      {
+        continue;
+      }
+
+      if ('\t' == c)
+      {
+        col = ((col / TAB_WIDTH) + 1) * TAB_WIDTH;
+        continue;
+      }
+
+      if (0x20 > c || 0x7f == c)
+      {
+        c = '.';
+      }
+
+      if (col >= left)
+      {
+        row_[col - left] = c;
+      }
+
+      col++;
+    }
+
+    if (avail > i && '\n' == p[i])
+    {
+      offset += (fl_off_t)i + 1;
+      break;
+    }
+
+    offset += (fl_off_t)i;
+  }
+
+  Fl::draw_puts(text_area.x, i_pos_y, row_, cols, i_fcolor, i_bcolor);
+
+  return offset;
+}
+
+void
+Fl_File_View::draw()
+{
+  enum Fl::foreground fcolor = skin_->normal_fcolor;
+  enum Fl::background bcolor = skin_->normal_bcolor;
+
+  if (false == active_r())
+  {
+    fcolor = skin_->disabled_fcolor;
+  }
+
+  Fl::clip_push(x(), y(), w(), h());
+
+  update_scrollbars();
+
+  if (damage() & (FL_DAMAGE_ALL | FL_DAMAGE_CHILD))
+  {
+    vscroll_->damage(FL_DAMAGE_ALL);
+    hscroll_->damage(FL_DAMAGE_ALL);
+  }
+
+  update_child(*vscroll_);
+  update_child(*hscroll_);
+
+  if (damage() & FL_DAMAGE_ALL)
+  {
+    Fl::draw_fill(x() + text_area.w, y() + text_area.h, 1, 1, 0x20,
+                  fcolor, bcolor);
+  }
+
+  if (damage() & (FL_DAMAGE_ALL | FL_DAMAGE_EXPOSE))
+  {
+    long const count = lines();
+    fl_off_t offset = 0;
+    unsigned int row = 0;
+
+    if (marks_ && top_ < count)
+    {
+      offset = line_offset(top_);
+    }
+
+    for (; text_area.h > row; row++)
+    {
+      long const line = top_ + (long)row;
+      int const ypos = text_area.y + (int)row;
+
+      if (line >= count || 0 == row_)
+      {
+        break;
+      }
+
+      offset = draw_row(offset, ypos,
+                        (line == found_) ? skin_->highlight_fcolor : fcolor,
+                        bcolor);
+    }
+
+    if (text_area.h > row)
+    {
+      Fl::draw_fill(text_area.x, text_area.y + (int)row, text_area.w,
+                    text_area.h - row, 0x20, fcolor, bcolor);
+    }
+  }
+
+  Fl::clip_pop();
+
+  return;
+}
+
+bool
+Fl_File_View::handle(
+  enum Fl_Event const event)
+{
+  long const page = (1 < text_area.h) ? (long)text_area.h - 1 : 1;
+
+  switch (event)
+  {
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+      return 1;
+
+    case FL_PUSH:
+      if (Fl::focus() != this &&
+          Fl::event_inside(text_area.x, text_area.y, text_area.w, text_area.h))
+      {
+        Fl::focus(this);
+        handle(FL_FOCUS);
+      }
+
+      Fl_Group::handle(event);
+      return 1;
+
+    case FL_MOUSEWHEEL:
+      if (Fl::event_dy()) return vscroll_->handle(event);
+
+      return hscroll_->handle(event);
+
+    case FL_KEYBOARD:
+      switch (Fl::event_key())
+      {
+        case FL_Up:
+          scroll_to(top_ - 1);
+          return 1;
+
+        case FL_Down:
+          scroll_to(top_ + 1);
+          return 1;
+
+        case FL_Page_Up:
+          scroll_to(top_ - page);
+          return 1;
+
+        case FL_Page_Down:
+          scroll_to(top_ + page);
+          return 1;
+
+        case FL_Home:
+          if (Fl::event_state() & FL_CTRL)
+          {
+            scroll_to(0);
+          }
+
+          else if (hoff_)
+          {
+            hoff_ = 0;
+            damage(FL_DAMAGE_EXPOSE);
+          }
+
+          return 1;
+
+        case FL_End:
+          scroll_to(LONG_MAX);
+          return 1;
+
+        case FL_Left:
+          if (hoff_)
+          {
+            hoff_--;
+            damage(FL_DAMAGE_EXPOSE);
+          }
+
+          return 1;
+
+        case FL_Right:
+          if ((fl_off_t)(hoff_ + text_area.w) < longest_)
+          {
+            hoff_++;
+            damage(FL_DAMAGE_EXPOSE);
+          }
+
+          return 1;
+
+        default:
+          break;
+      }
+
+      break;
+
+    default:
+      break;
+  }
+
+  return Fl_Group::handle(event);
+}
@@ -192,6 +192,311 @@ navkey()
   return 0;
 }
 
+/*
+  Spatial index over the child rectangles.  Groups with many children
+  bucket them into a grid laid over the union of their rectangles, with
+  about one cell per child; each cell lists the children overlapping it
+  from the top of the stacking order down.  A child's rectangle is
+  widened to cover a label drawn outside it.  The grid serves both point
+  queries for mouse events and clip queries for drawing.  It is built on
+  first use and dropped whenever a child is added, removed, moved or
+  realigned.
+*/
+struct Fl_Hit_Grid
+{
+  int x;
+  int y;
+  int cell_w;
+  int cell_h;
+  int cols;
+  int rows;
+  int* cell;
+  int* list;
+};
+
+enum
+{
+  HIT_MIN_CHILDREN = 32
+};
+
+void
+Fl_Group::hit_clear()
+{
+  if (hits_)
+  {
+    delete[] hits_->cell;
+    delete[] hits_->list;
+    delete hits_;
+    hits_ = 0;
+  }
+}
+
+// The area a child may paint: its own box plus any outside label,
+// which draw_outside_label() lets run to the edge of the group.
+void
+Fl_Group::hit_extent(const Fl_Widget& o, int& L, int& T, int& R, int& B)
+{
+  int wx = as_window() ? 0 : x();
+  int wy = as_window() ? 0 : y();
+  Fl_Label::Fl_Align a = o.align();
+  int p = a & Fl_Label::FL_ALIGN_POSITION_MASK;
+
+  L = o.x();
+  T = o.y();
+  R = o.x() + (int)o.w();
+  B = o.y() + (int)o.h();
+
+  if (!(a & 15) || (a & Fl_Label::FL_ALIGN_INSIDE)) return;
+
+  if (p == Fl_Label::FL_ALIGN_LEFT_TOP || p == Fl_Label::FL_ALIGN_LEFT_BOTTOM)
+  {
+    if (wx < L) L = wx;
+  }
+
+  else if (p == Fl_Label::FL_ALIGN_RIGHT_TOP
+           || p == Fl_Label::FL_ALIGN_RIGHT_BOTTOM)
+  {
+    if (wx + (int)w() > R) R = wx + (int)w();
+  }
+
+  else if (a & Fl_Label::FL_ALIGN_TOP)
+  {
+    if (wy < T) T = wy;
+  }
+
+  else if (a & Fl_Label::FL_ALIGN_BOTTOM)
+  {
+    if (wy + (int)h() > B) B = wy + (int)h();
+  }
+
+  else if (a & Fl_Label::FL_ALIGN_LEFT)
+  {
+    if (wx < L) L = wx;
+  }
+
+  else if (a & Fl_Label::FL_ALIGN_RIGHT)
+  {
+    if (wx + (int)w() > R) R = wx + (int)w();
+  }
+}
+
+void
+Fl_Group::hit_build()
+{
+  Fl_Widget* const* a = array();
+  Fl_Hit_Grid* g = new Fl_Hit_Grid;
+  int left = 0, top = 0, right = 0, bottom = 0;
+  int L, T, R, B;
+  bool any = false;
+  int i, cells, row, col;
+
+  for (i = 0; i < children_; i++)
+  {
+    if (!a[i]->w() || !a[i]->h()) continue;
+
+    hit_extent(*a[i], L, T, R, B);
+
+    if (!any || L < left) left = L;
+
+    if (!any || T < top) top = T;
+
+    if (!any || R > right) right = R;
+
+    if (!any || B > bottom) bottom = B;
+
+    any = true;
+  }
+
+  g->x = left;
+  g->y = top;
+
+  // about one cell per child, shaped after the covered area
+  for (g->cols = 1;
+       g->cols < right - left &&
+       g->cols * g->cols * (bottom - top) < children_ * (right - left);
+       g->cols++) ;
+
+  g->rows = (children_ + g->cols - 1) / g->cols;
+
+  if (g->rows > bottom - top) g->rows = bottom - top;
+
+  if (g->rows < 1) g->rows = 1;
+
+  g->cell_w = (right - left + g->cols - 1) / g->cols;
+  g->cell_h = (bottom - top + g->rows - 1) / g->rows;
+
+  if (g->cell_w < 1) g->cell_w = 1;
+
+  if (g->cell_h < 1) g->cell_h = 1;
+
+  cells = g->cols * g->rows;
+  g->cell = new int[cells + 1];
+  g->list = 0;
+
+  for (i = 0; i <= cells; i++) g->cell[i] = 0;
+
+  for (int pass = 0; pass < 2; pass++)
+  {
+    int* fill = 0;
+
+    if (pass)
+    {
+      for (i = 0; i < cells; i++) g->cell[i + 1] += g->cell[i];
+
+      g->list = new int[g->cell[cells] + 1];
+      fill = new int[cells];
+
+      for (i = 0; i < cells; i++) fill[i] = g->cell[i];
+    }
+
+    for (i = children_; i--;)
+    {
+      if (!a[i]->w() || !a[i]->h()) continue;
+
+      hit_extent(*a[i], L, T, R, B);
+
+      int c0 = (L - left) / g->cell_w;
+      int c1 = (R - 1 - left) / g->cell_w;
+      int r0 = (T - top) / g->cell_h;
+      int r1 = (B - 1 - top) / g->cell_h;
+
+      for (row = r0; row <= r1; row++)
+      {
+        for (col = c0; col <= c1; col++)
+        {
+          if (pass) g->list[fill[row * g->cols + col]++] = i;
+
+          else g->cell[row * g->cols + col + 1]++;
+        }
+      }
+    }
+
+    delete[] fill;
+  }
+
+  hits_ = g;
+}
+
+// Returns the next child below index i that may hold the event point,
+// or -1.  Small groups simply step through every child.
+int
+Fl_Group::hit_next(int const i)
+{
+  if (children_ < HIT_MIN_CHILDREN) return i - 1;
+
+  if (!hits_) hit_build();
+
+  int col = Fl::e_x - hits_->x;
+  int row = Fl::e_y - hits_->y;
+
+  if (col < 0 || row < 0) return -1;
+
+  col /= hits_->cell_w;
+  row /= hits_->cell_h;
+
+  if (col >= hits_->cols || row >= hits_->rows) return -1;
+
+  int const* list = hits_->list + hits_->cell[row * hits_->cols + col];
+  int n = hits_->cell[row * hits_->cols + col + 1] -
+          hits_->cell[row * hits_->cols + col];
+  int lo = 0, hi = n;
+
+  while (lo < hi)
+  {
+    int mid = (lo + hi) / 2;
+
+    if (list[mid] < i) hi = mid;
+
+    else lo = mid + 1;
+  }
+
+  return (lo < n) ? list[lo] : -1;
+}
+
+static int
+ascending(const void* a, const void* b)
+{
+  return *(const int*)a - *(const int*)b;
+}
+
+/*
+  Draws the first count children in stacking order, skipping those the
+  spatial index places outside the current clip before any of their
+  drawing code runs.  With update set only damaged children are drawn.
+*/
+void
+Fl_Group::draw_clipped(int const count, bool const update)
+{
+  Fl_Widget* const* a = array();
+  int* pick = 0;
+  int picks = count;
+  int i;
+
+  if (count >= HIT_MIN_CHILDREN)
+  {
+    int X, Y;
+    unsigned int W, H;
+
+    if (!hits_) hit_build();
+
+    Fl_Hit_Grid const* g = hits_;
+
+    Fl::clip_box(X, Y, W, H, g->x, g->y, g->cols * g->cell_w,
+                 g->rows * g->cell_h);
+    X -= Fl_Graphics_Driver::draw_offset_x;
+    Y -= Fl_Graphics_Driver::draw_offset_y;
+
+    if (!W || !H) return;
+
+    int c0 = (X - g->x) / g->cell_w;
+    int c1 = (X + (int)W - 1 - g->x) / g->cell_w;
+    int r0 = (Y - g->y) / g->cell_h;
+    int r1 = (Y + (int)H - 1 - g->y) / g->cell_h;
+
+    if (c0 || r0 || c1 < g->cols - 1 || r1 < g->rows - 1)
+    {
+      int n = 0;
+
+      for (int row = r0; row <= r1; row++)
+        n += g->cell[row * g->cols + c1 + 1] - g->cell[row * g->cols + c0];
+
+      pick = new int[n + 1];
+      picks = 0;
+
+      for (int row = r0; row <= r1; row++)
+      {
+        for (int k = g->cell[row * g->cols + c0];
+             k < g->cell[row * g->cols + c1 + 1]; k++)
+        {
+          if (g->list[k] < count) pick[picks++] = g->list[k];
+        }
+      }
+
+      qsort(pick, picks, sizeof(int), ascending);
+
+      for (i = n = 0; i < picks; i++)
+        if (!n || pick[n - 1] != pick[i]) pick[n++] = pick[i];
+
+      picks = n;
+    }
+  }
+
+  for (i = 0; i < picks; i++)
+  {
+    Fl_Widget& o = *a[pick ? pick[i] : i];
+
+    if (update) update_child(o);
+
+    else
+    {
+      draw_child(o);
+      draw_outside_label(o);
+    }
+  }
+
+  delete[] pick;
+}
+
 bool
 Fl_Group::handle(Fl_Event const event)
 {
@@ -232,7 +537,7 @@ Fl_Group::handle(Fl_Event const event)
       return navigation(navkey());
 
     case FL_SHORTCUT:
-      for (i = children(); i--;)
+      for (i = hit_next(children()); i >= 0; i = hit_next(i))
       {
         o = a[i];
 
@@ -255,7 +560,7 @@ Fl_Group::handle(Fl_Event const event)
 
     case FL_ENTER:
     case FL_MOVE:
-      for (i = children(); i--;)
+      for (i = hit_next(children()); i >= 0; i = hit_next(i))
       {
         o = a[i];
 
@@ -280,7 +585,7 @@ Fl_Group::handle(Fl_Event const event)
 
     case FL_DND_ENTER:
     case FL_DND_DRAG:
-      for (i = children(); i--;)
+      for (i = hit_next(children()); i >= 0; i = hit_next(i))
       {
         o = a[i];
 
@@ -304,7 +609,7 @@ Fl_Group::handle(Fl_Event const event)
       return 0;
 
     case FL_PUSH:
-      for (i = children(); i--;)
+      for (i = hit_next(children()); i >= 0; i = hit_next(i))
       {
         o = a[i];
 
@@ -333,7 +638,7 @@ Fl_Group::handle(Fl_Event const event)
 
       else
       {
-        for (i = children(); i--;)
+        for (i = hit_next(children()); i >= 0; i = hit_next(i))
         {
           o = a[i];
 
@@ -347,7 +652,7 @@ Fl_Group::handle(Fl_Event const event)
       return 0;
 
     case FL_MOUSEWHEEL:
-      for (i = children(); i--;)
+      for (i = hit_next(children()); i >= 0; i = hit_next(i))
       {
         o = a[i];
 
@@ -516,6 +821,7 @@ Fl_Group::Fl_Group(
   resizable_ = this;
   bounds_ = 0;
   sizes_ = 0;
+  hits_ = 0;
   begin();
 }
 
@@ -584,6 +890,7 @@ Fl_Group::clear()
 Fl_Group::~Fl_Group()
 {
   clear();
+  hit_clear();
 }
 
 void
@@ -701,6 +1008,7 @@ Fl_Group::init_sizes()
   bounds_ = 0;
   delete[] sizes_;
   sizes_ = 0;
+  hit_clear();
 }
 
 Fl_Rect*
@@ -842,27 +1150,12 @@ Fl_Group::resize(
 void
 Fl_Group::draw_children()
 {
-  Fl_Widget* const* a = array();
-
   if (clip_children())
   {
     Fl::clip_push(x(), y(), w(), h());
   }
 
-  if (damage() & ~FL_DAMAGE_CHILD)
-  {
-    for (int i = children_; i--;)
-    {
-      Fl_Widget& o = **a++;
-      draw_child(o);
-      draw_outside_label(o);
-    }
-  }
-
-  else
-  {
-    for (int i = children_; i--;) update_child(**a++);
-  }
+  draw_clipped(children_, !(damage() & ~FL_DAMAGE_CHILD));
 
   if (clip_children()) Fl::clip_pop();
 }
@@ -1006,14 +1299,14 @@ Fl_Group::draw_outside_label(const Fl_Widget& widget) const
 
   if (&widget != Fl::focus())
   {
-    l_fcolor = skin_.normal_fcolor;
-    l_bcolor = skin_.normal_bcolor;
+    l_fcolor = skin_->normal_fcolor;
+    l_bcolor = skin_->normal_bcolor;
   }
 
   else
   {
-    l_fcolor = skin_.focused_fcolor;
-    l_bcolor = skin_.focused_bcolor;
+    l_fcolor = skin_->focused_fcolor;
+    l_bcolor = skin_->focused_bcolor;
   }
 
   widget.draw_label(X, Y, W, H, a, l_fcolor, l_bcolor, l_fcolor);
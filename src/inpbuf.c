@@ -12,6 +12,7 @@
 #include <string.h>
 
 #define INPBUF_GROWBY 128
+#define INPLIST_GROWBY 64
 
 static struct inpbuf*
 inplist_alloc(
@@ -34,12 +35,108 @@ inplist_alloc(
   return l_buf;
 }
 
+static void
+inplist_release(
+  struct inplist* const io_list,
+  struct inpbuf* const io_buf)
+{
+
+  (*io_buf).m_length = 0;
+  (*io_buf).m_next = (*io_list).m_free;
+  (*io_list).m_free = io_buf;
+
+  return;
+}
+
+static void
+inplist_move_gap(
+  struct inplist* const io_list,
+  size_t const i_slot)
+{
+  struct inpbuf** l_line;
+  size_t l_count;
+
+  l_line = (*io_list).m_line;
+
+  if (i_slot < (*io_list).m_gap)
+  {
+    l_count = (*io_list).m_gap - i_slot;
+    memmove(
+      l_line + (*io_list).m_gap_end - l_count,
+      l_line + i_slot,
+      l_count * sizeof(*l_line));
+    (*io_list).m_gap -= l_count;
+    (*io_list).m_gap_end -= l_count;
+  }
+
+  else if (i_slot > (*io_list).m_gap)
+  {
+    l_count = i_slot - (*io_list).m_gap;
+    memmove(
+      l_line + (*io_list).m_gap,
+      l_line + (*io_list).m_gap_end,
+      l_count * sizeof(*l_line));
+    (*io_list).m_gap += l_count;
+    (*io_list).m_gap_end += l_count;
+  }
+
+  return;
+}
+
+static int
+inplist_reserve(
+  struct inplist* const io_list)
+{
+  int l_exit;
+  struct inpbuf** l_block;
+  size_t l_alloc;
+  size_t l_tail;
+
+  l_exit = 1;
+
+  do
+  {
+
+    if ((*io_list).m_gap < (*io_list).m_gap_end)
+    {
+      break;
+    }
+
+    l_alloc = (*io_list).m_alloc ? (2 * (*io_list).m_alloc) : INPLIST_GROWBY;
+
+    l_block = (struct inpbuf**)realloc(
+                (*io_list).m_line,
+                l_alloc * sizeof(*l_block));
+
+    if (0 == l_block)
+    {
+      l_exit = 0;
+      break;
+    }
+
+    l_tail = (*io_list).m_alloc - (*io_list).m_gap_end;
+
+    memmove(
+      l_block + l_alloc - l_tail,
+      l_block + (*io_list).m_gap_end,
+      l_tail * sizeof(*l_block));
+
+    (*io_list).m_line = l_block;
+    (*io_list).m_gap_end = l_alloc - l_tail;
+    (*io_list).m_alloc = l_alloc;
+
+  }
+  while (0);
+
+  return l_exit;
+}
 
 struct inplist*
 inplist_new()
 {
   struct inplist* l_list;
   l_list = (struct inplist*)calloc(1, sizeof(*l_list));
+  (*l_list).m_dirty = 1;
   return l_list;
 }
 
@@ -50,15 +147,7 @@ inplist_free(
   struct inpbuf* l_buf;
   struct inpbuf* l_next;
 
-  l_buf = (*io_list).m_head;
-
-  while (l_buf)
-  {
-    l_next = (*l_buf).m_next;
-    free((*l_buf).m_data);
-    free(l_buf);
-    l_buf = l_next;
-  };
+  inplist_clear(io_list);
 
   l_buf = (*io_list).m_free;
 
@@ -70,6 +159,8 @@ inplist_free(
     l_buf = l_next;
   };
 
+  free((*io_list).m_line);
+  free((*io_list).m_string);
   free(io_list);
 
   return;
@@ -79,26 +170,18 @@ void
 inplist_clear(
   struct inplist* const io_list)
 {
-  struct inpbuf* l_node;
+  size_t l_slot;
 
-  if ((*io_list).m_head)
+  for (l_slot = 0; l_slot < (*io_list).m_size; l_slot++)
   {
-    (*io_list).m_tail->m_next = (*io_list).m_free;
-    (*io_list).m_free = (*io_list).m_head;
-    (*io_list).m_head = 0;
-    (*io_list).m_tail = 0;
-    (*io_list).m_size = 0;
-
-    l_node = (*io_list).m_free;
-
-    while (l_node)
-    {
-      (*l_node).m_length = 0;
-      (*l_node).m_prev = 0;
-      l_node = (*l_node).m_next;
-    }
+    inplist_release(io_list, inplist_nth(io_list, l_slot));
   }
 
+  (*io_list).m_gap = 0;
+  (*io_list).m_gap_end = (*io_list).m_alloc;
+  (*io_list).m_size = 0;
+  (*io_list).m_dirty = 1;
+
   return;
 }
 
@@ -106,26 +189,7 @@ struct inpbuf*
 inplist_append(
   struct inplist* const io_list)
 {
-  struct inpbuf* l_buf;
-
-  l_buf = inplist_alloc(io_list);
-
-  if ((*io_list).m_tail)
-  {
-    (*l_buf).m_prev = (*io_list).m_tail;
-    (*io_list).m_tail->m_next = l_buf;
-    (*io_list).m_tail = l_buf;
-    (*io_list).m_size++;
-  }
-
-  else
-  {
-    (*io_list).m_head = l_buf;
-    (*io_list).m_tail = l_buf;
-    (*io_list).m_size = 1;
-  }
-
-  return l_buf;
+  return inplist_insert(io_list, (*io_list).m_size);
 }
 
 struct inpbuf*
@@ -133,55 +197,36 @@ inplist_insert(
   struct inplist* const io_list,
   size_t const i_slot)
 {
-  struct inpbuf* l_node;
   struct inpbuf* l_buf;
   size_t l_slot;
 
-  l_node = 0;
-
-  for (l_slot = (*io_list).m_size; l_slot < i_slot; l_slot++)
-  {
-    inplist_append(io_list);
-  }
-
-  l_node = (*io_list).m_head;
-
-  for (l_slot = 0; l_slot < i_slot; l_slot++)
-  {
-    l_node = (*l_node).m_next;
-  }
-
-  if (l_node)
+  do
   {
-    l_buf = inplist_alloc(io_list);
 
-    (*l_buf).m_prev = (*l_node).m_prev;
+    l_buf = 0;
 
-    if ((*l_node).m_prev)
+    if (0 == inplist_reserve(io_list))
     {
-      (*l_node).m_prev->m_next = l_buf;
+      break;
     }
 
-    (*l_node).m_prev = l_buf;
-    (*l_buf).m_next = l_node;
+    l_buf = inplist_alloc(io_list);
 
-    if ((*io_list).m_head == l_node)
+    if (0 == l_buf)
     {
-      (*io_list).m_head = l_buf;
+      break;
     }
 
-    if ((*io_list).m_tail == l_node)
-    {
-      (*io_list).m_tail = l_buf;
-    }
+    /* a slot past the end is reached by appending empty lines */
+    l_slot = ((*io_list).m_size < i_slot) ? (*io_list).m_size : i_slot;
 
+    inplist_move_gap(io_list, l_slot);
+    (*io_list).m_line[(*io_list).m_gap++] = l_buf;
     (*io_list).m_size++;
-  }
+    (*io_list).m_dirty = 1;
 
-  else
-  {
-    l_buf = inplist_append(io_list);
   }
+  while (l_slot < i_slot);
 
   return l_buf;
 }
@@ -191,44 +236,13 @@ inplist_remove(
   struct inplist* const io_list,
   size_t const i_slot)
 {
-  struct inpbuf* l_node;
-  size_t l_slot;
-
-  l_node = (*io_list).m_head;
-
-  for (l_slot = 0; l_slot < i_slot; l_slot++)
-  {
-    l_node = (*l_node).m_next;
-  }
 
-  if (l_node)
+  if (i_slot < (*io_list).m_size)
   {
-
-    if ((*l_node).m_prev)
-    {
-      (*l_node).m_prev->m_next = (*l_node).m_next;
-    }
-
-    if ((*l_node).m_next)
-    {
-      (*l_node).m_next->m_prev = (*l_node).m_prev;
-    }
-
-    if ((*io_list).m_head == l_node)
-    {
-      (*io_list).m_head = (*l_node).m_next;
-    }
-
-    if ((*io_list).m_tail == l_node)
-    {
-      (*io_list).m_tail = (*l_node).m_prev;
-    }
-
-    (*l_node).m_length = 0;
-    (*l_node).m_next = (*io_list).m_free;
-    (*l_node).m_prev = 0;
-    (*io_list).m_free = l_node;
+    inplist_move_gap(io_list, i_slot);
+    inplist_release(io_list, (*io_list).m_line[(*io_list).m_gap_end++]);
     (*io_list).m_size--;
+    (*io_list).m_dirty = 1;
   }
 
   return;
@@ -236,64 +250,71 @@ inplist_remove(
 
 extern unsigned char*
 inplist_as_string(
-  struct inplist const* const i_list)
+  struct inplist* const io_list)
 {
   struct inpbuf const* l_buf;
-  unsigned char* l_str;
+  unsigned char* l_block;
   unsigned char* l_tail;
   size_t l_size;
+  size_t l_slot;
 
-  l_str = 0;
-  l_size = 0;
-
-  for (l_buf = (*i_list).m_head; l_buf; l_buf = (*l_buf).m_next)
+  do
   {
-    l_size += (1 + (*l_buf).m_length);
-  };
 
-  l_size += (1 + (*i_list).m_size);
-
-  l_str = (unsigned char*)calloc(1, l_size);
+    if (0 == (*io_list).m_dirty && (*io_list).m_string)
+    {
+      break;
+    }
 
-  l_tail = l_str;
+    l_size = 1 + (*io_list).m_size;
 
-  for (l_buf = (*i_list).m_head; l_buf; l_buf = (*l_buf).m_next)
-  {
-    memcpy(l_tail, (*l_buf).m_data, (*l_buf).m_length);
-    l_tail += (*l_buf).m_length;
+    for (l_slot = 0; l_slot < (*io_list).m_size; l_slot++)
+    {
+      l_size += (*inplist_nth(io_list, l_slot)).m_length;
+    };
 
-    if ((*l_buf).m_next)
+    if ((*io_list).m_string_size < l_size)
     {
-      *l_tail++ = '\n';
-    }
-  };
+      l_block = (unsigned char*)realloc((*io_list).m_string, l_size);
 
-  return l_str;
-}
+      if (0 == l_block)
+      {
+        break;
+      }
 
-size_t
-inplist_slot(
-  struct inplist const* const i_list,
-  struct inpbuf const* const i_buf)
-{
-  struct inpbuf* l_head;
-  size_t l_slot;
+      (*io_list).m_string = l_block;
+      (*io_list).m_string_size = l_size;
+    }
 
-  l_head = (*i_list).m_head;
-  l_slot = 0;
+    l_tail = (*io_list).m_string;
 
-  while (l_head)
-  {
-    if (i_buf == l_head)
+    for (l_slot = 0; l_slot < (*io_list).m_size; l_slot++)
     {
-      break;
-    }
+      l_buf = inplist_nth(io_list, l_slot);
+      memcpy(l_tail, (*l_buf).m_data, (*l_buf).m_length);
+      l_tail += (*l_buf).m_length;
 
-    l_head = (*l_head).m_next;
-    l_slot++;
-  };
+      if ((1 + l_slot) < (*io_list).m_size)
+      {
+        *l_tail++ = '\n';
+      }
+    };
+
+    *l_tail = 0;
+    (*io_list).m_dirty = 0;
+
+  }
+  while (0);
 
-  return l_slot;
+  return (*io_list).m_string;
+}
+
+void
+inplist_touch(
+  struct inplist* const io_list)
+{
+  (*io_list).m_dirty = 1;
+  return;
 }
 
 struct inpbuf*
@@ -301,21 +322,18 @@ inplist_nth(
   struct inplist* const i_list,
   size_t const i_slot)
 {
-  size_t l_slot;
   struct inpbuf* l_buf;
 
-  l_buf = (*i_list).m_head;
-  l_slot = 0;
+  l_buf = 0;
 
-  while (l_buf)
+  if (i_slot < (*i_list).m_gap)
   {
-    if (i_slot == l_slot)
-    {
-      break;
-    }
+    l_buf = (*i_list).m_line[i_slot];
+  }
 
-    l_buf = (*l_buf).m_next;
-    l_slot++;
+  else if (i_slot < (*i_list).m_size)
+  {
+    l_buf = (*i_list).m_line[i_slot + (*i_list).m_gap_end - (*i_list).m_gap];
   }
 
   return l_buf;
@@ -86,7 +86,7 @@ Fl_Input_Choice::InputMenuButton::draw()
 {
 
   Fl::draw_putc(x_ + w_ - 1, y_, Fl::_skin_sym.down, 1,
-                skin_.normal_fcolor, skin_.normal_bcolor);
+                skin_->normal_fcolor, skin_->normal_bcolor);
 
   return;
 }
@@ -234,9 +234,10 @@ inpcur_up(
 
   l_mod = MOD_NONE;
 
-  if ((*io_cur).m_active->m_prev)
+  if ((*io_cur).m_line)
   {
-    (*io_cur).m_active = (*io_cur).m_active->m_prev;
+    (*io_cur).m_line--;
+    (*io_cur).m_active = inplist_nth((*io_cur).m_list, (*io_cur).m_line);
 
     if ((*io_cur).m_caret_y)
     {
@@ -264,9 +265,10 @@ inpcur_down(
 
   l_mod = MOD_NONE;
 
-  if ((*io_cur).m_active->m_next)
+  if ((1 + (*io_cur).m_line) < (*io_cur).m_list->m_size)
   {
-    (*io_cur).m_active = (*io_cur).m_active->m_next;
+    (*io_cur).m_line++;
+    (*io_cur).m_active = inplist_nth((*io_cur).m_list, (*io_cur).m_line);
 
     if ((*io_cur).m_len_y && ((*io_cur).m_len_y - 1) > (*io_cur).m_caret_y)
     {
@@ -300,6 +302,7 @@ inpcur_ins(
 
   if (l_result)
   {
+    inplist_touch((*io_cur).m_list);
     l_mod = inpcur_right(io_cur);
   }
 
@@ -320,6 +323,7 @@ inpcur_ovw(
 
   if (l_result)
   {
+    inplist_touch((*io_cur).m_list);
     l_mod = inpcur_right(io_cur);
   }
 
@@ -333,7 +337,6 @@ inpcur_del(
   unsigned int l_mod;
   int l_result;
   struct inpbuf* l_buf;
-  size_t l_slot;
 
   l_mod = MOD_NONE;
 
@@ -343,13 +346,14 @@ inpcur_del(
 
     if (l_result)
     {
+      inplist_touch((*io_cur).m_list);
       l_mod = MOD_LINE;
     }
   }
 
   else
   {
-    l_buf = (*io_cur).m_active->m_next;
+    l_buf = inplist_nth((*io_cur).m_list, (1 + (*io_cur).m_line));
 
     if (l_buf)
     {
@@ -367,8 +371,7 @@ inpcur_del(
           (*io_cur).m_active->m_length += (*l_buf).m_length;
         }
 
-        l_slot = inplist_slot((*io_cur).m_list, l_buf);
-        inplist_remove((*io_cur).m_list, l_slot);
+        inplist_remove((*io_cur).m_list, (1 + (*io_cur).m_line));
         l_mod = MOD_EXPOSE;
       }
     }
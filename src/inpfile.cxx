@@ -88,6 +88,12 @@ Fl_File_Input::Fl_File_Input(
   buttons_[0] = 0;
   ok_entry_   = 1;
   pressed_    = -1;
+  complete_pending_ = false;
+}
+
+Fl_File_Input::~Fl_File_Input()
+{
+  Fl_Dir_Cache::cancel(this);
 }
 
 void
@@ -232,6 +238,23 @@ Fl_File_Input::handle(enum Fl_Event const event)
       else
         return Fl_Input::handle(event);
 
+    case FL_UNFOCUS :
+      complete_pending_ = false;
+      Fl_Dir_Cache::cancel(this);
+      return Fl_Input::handle(event);
+
+    case FL_KEYBOARD :
+      // Tab moves the focus on when there is nothing to complete
+      if (Fl::event_key() == FL_Tab &&
+          !Fl::event_state(FL_SHIFT | FL_CTRL | FL_ALT | FL_META) &&
+          value()[0] && complete())
+      {
+        return 1;
+      }
+
+      complete_pending_ = false;
+
+    // fall through
     default :
     {
       Fl_Widget_Tracker wp(this);
@@ -250,6 +273,110 @@ Fl_File_Input::handle(enum Fl_Event const event)
 }
 
 
+/*
+  Completes the last part of the path as far as the names in its
+  directory agree.  The directory is listed in the background the first
+  time, and the completion is made once the listing is in, unless
+  another key has been pressed meanwhile.  Returns whether text was
+  added or the listing is awaited.  Listings are shared through
+  Fl_Dir_Cache, so a directory is read again only once it has changed.
+*/
+bool
+Fl_File_Input::complete()
+{
+  unsigned char const* val = value();
+  unsigned char const* base = val;
+  unsigned char const* sep;
+  char dir[FL_PATH_MAX];
+  char newvalue[FL_PATH_MAX];
+
+  while ((sep = Fl::system_driver()->next_dir_sep(base)) != NULL)
+    base = sep + 1;
+
+  size_t dirlen = base - val;
+
+  if (dirlen >= sizeof(dir)) return false;
+
+  if (dirlen)
+  {
+    memcpy(dir, val, dirlen);
+    dir[dirlen] = 0;
+  }
+
+  else strlcpy(dir, ".", sizeof(dir));
+
+  Fl_Dir_List* list = Fl_Dir_Cache::list(dir, list_cb, this);
+
+  if (!list) return false;
+
+  if (!list->done())
+  {
+    complete_pending_ = true;
+    return true;
+  }
+
+  size_t len = strlen((char const*)base);
+  int first = list->find((char const*)base);
+  int last = first;
+  char const* name;
+
+  while ((name = list->name(last)) && !strncmp(name, (char const*)base, len))
+    last++;
+
+  if (first == last) return false;
+
+  // the names are sorted, so the first and last match share the prefix
+  char const* a = list->name(first);
+  char const* b = list->name(last - 1);
+  size_t common = 0;
+
+  while (a[common] && a[common] == b[common]) common++;
+
+  if (dirlen + common + 2 > sizeof(newvalue)) return false;
+
+  memcpy(newvalue, val, dirlen);
+  memcpy(newvalue + dirlen, a, common);
+  size_t size = dirlen + common;
+  newvalue[size] = 0;
+
+  if (last - first == 1 && list->isdir(first))
+  {
+#if defined(__DOS__) || defined(__NT__)
+    newvalue[size++] = '\\';
+#else
+    newvalue[size++] = '/';
+#endif
+    newvalue[size] = 0;
+  }
+
+  if (size > dirlen + len)
+  {
+    value((unsigned char*)newvalue, (int)size);
+    end();
+    set_changed();
+
+    if (when() & FL_WHEN_CHANGED) do_callback();
+
+    return true;
+  }
+
+  return false;
+}
+
+void
+Fl_File_Input::list_cb(Fl_Dir_List* list, void* data)
+{
+  Fl_File_Input* inp = reinterpret_cast<Fl_File_Input*>(data);
+
+  if (inp->complete_pending_)
+  {
+    inp->complete_pending_ = false;
+    inp->complete();
+  }
+
+  return;
+}
+
 int
 Fl_File_Input::handle_button(int event)
 {
@@ -379,8 +379,7 @@ enum Fl_Widget::Fl_Damage
 Fl_Input::nl()
 {
   unsigned int l_damage = Fl_Widget::FL_DAMAGE_NONE;
-  size_t l_slot = inplist_slot((*cur_).m_list, (*cur_).m_active);
-  struct inpbuf* l_buf = inplist_insert((*cur_).m_list, (1 + l_slot));
+  struct inpbuf* l_buf = inplist_insert((*cur_).m_list, (1 + (*cur_).m_line));
   unsigned int l_len = (*cur_).m_active->m_length - (*cur_).m_slot_x;
 
   if (l_len)
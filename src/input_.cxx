@@ -119,6 +119,7 @@ Fl_Input_::value(
   inplist_clear((*cur_).m_list);
 
   (*cur_).m_active = 0;
+  (*cur_).m_line = 0;
   (*cur_).m_caret_x = 0;
   (*cur_).m_slot_x = 0;
   (*cur_).m_sticky_x = 0;
@@ -156,7 +157,12 @@ Fl_Input_::value(
     inpbuf_copy(l_buf, l_head, l_size);
   }
 
-  (*cur_).m_active = (*cur_).m_list->m_head;
+  (*cur_).m_active = inplist_nth((*cur_).m_list, 0);
+
+  if (0 == (*cur_).m_active)
+  {
+    (*cur_).m_active = inplist_append((*cur_).m_list);
+  }
 
   return;
 }
@@ -203,7 +209,7 @@ Fl_Input_::drawtext(
     }
 
     l_line++;
-    l_buf = (*l_buf).m_next;
+    l_buf = inplist_nth((*cur_).m_list, ((*cur_).m_offset_y + l_line));
 
   }
   while (1);
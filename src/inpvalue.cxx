@@ -221,6 +221,7 @@ Fl_Value_Input::Fl_Value_Input(
   align(Fl_Label::FL_ALIGN_LEFT);
   value_damage();
   set_flag(SHORTCUT_LABEL);
+  update_label_shortcut();
 }
 
 Fl_Value_Input::~Fl_Value_Input()
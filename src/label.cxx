@@ -192,14 +192,14 @@ Fl_Widget::draw_label(
 
   if (this != Fl::focus())
   {
-    l_fcolor = skin_.normal_fcolor;
-    l_bcolor = skin_.normal_bcolor;
+    l_fcolor = skin_->normal_fcolor;
+    l_bcolor = skin_->normal_bcolor;
   }
 
   else
   {
-    l_fcolor = skin_.focused_fcolor;
-    l_bcolor = skin_.focused_bcolor;
+    l_fcolor = skin_->focused_fcolor;
+    l_bcolor = skin_->focused_bcolor;
   }
 
   draw_label(i_pos_x, i_pos_y, i_len_x, i_len_y,
@@ -223,8 +223,8 @@ Fl_Widget::draw_label(
   {
     if (flags()&SHORTCUT_LABEL) fl_draw_shortcut = 1;
 
-    Fl_Label::draw(i_pos_x, i_pos_y, i_len_x, i_len_y,
-                   label_.value, i_align, i_fcolor, i_bcolor, i_hcolor);
+    fl_draw(layout_, label_.value, i_pos_x, i_pos_y, i_len_x, i_len_y,
+            i_align, i_fcolor, i_bcolor, i_hcolor);
     fl_draw_shortcut = 0;
   }
 }
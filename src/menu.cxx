@@ -68,6 +68,7 @@
 //
 #include <stdio.h>
 #include "menu_.h"
+#include "block.h"
 #include "drvwin.h"
 #include "drvsys.h"
 #include "fl.h"
@@ -151,6 +152,120 @@ Fl_Menu_Item::next(int n) const
 static const Fl_Menu_* button = 0;
 #define LEADING 4
 
+// Submenus shown lately, so opening one again skips measuring its items
+// and puts back the cells drawn last time instead of drawing them.  A
+// slot is found by the menu and a checksum of its items, so a menu
+// whose items changed in any way is measured and drawn afresh.  The
+// skins are kept by value, as a theme is changed by editing them.
+struct menucache
+{
+  const Fl_Menu_Item* menu;
+  unsigned long version;
+  struct Fl::skin_widget skin;
+  struct Fl::skin_widget button_skin;
+  struct Fl::skin_symbols sym;
+  int width;
+  int keys_width;
+  int mods_width;
+  struct block* cells;
+  unsigned int cells_offset;
+  int cells_selected;
+  unsigned long used;
+};
+
+enum
+{
+  MENUCACHE_SLOTS = 8
+};
+
+static menucache menucache_[MENUCACHE_SLOTS];
+static unsigned long menucache_used = 0;
+
+// the skins the menu is drawn with, the button's zeroed if none
+static void
+menucache_skins(menucache& c, const struct Fl::skin_widget* skin)
+{
+  c.skin = *skin;
+
+  if (button) c.button_skin = *button->skin_;
+
+  else memset(&c.button_skin, 0, sizeof(c.button_skin));
+
+  c.sym = Fl::_skin_sym;
+}
+
+static menucache*
+menucache_find(const Fl_Menu_Item* menu, unsigned long version,
+               const struct Fl::skin_widget* skin)
+{
+  menucache now;
+
+  menucache_skins(now, skin);
+
+  for (int i = 0; i < MENUCACHE_SLOTS; i++)
+  {
+    menucache& c = menucache_[i];
+
+    if (c.menu == menu && c.version == version &&
+        !memcmp(&c.skin, &now.skin, sizeof(now.skin)) &&
+        !memcmp(&c.button_skin, &now.button_skin, sizeof(now.button_skin)) &&
+        !memcmp(&c.sym, &now.sym, sizeof(now.sym)))
+    {
+      c.used = ++menucache_used;
+      return &c;
+    }
+  }
+
+  return 0;
+}
+
+static menucache*
+menucache_take(const Fl_Menu_Item* menu, unsigned long version,
+               const struct Fl::skin_widget* skin)
+{
+  menucache* c = &menucache_[0];
+
+  for (int i = 1; i < MENUCACHE_SLOTS; i++)
+    if (menucache_[i].used < c->used) c = &menucache_[i];
+
+  c->menu = menu;
+  c->version = version;
+  menucache_skins(*c, skin);
+  c->used = ++menucache_used;
+
+  if (!c->cells) c->cells = block_new();
+
+  // no cells until the menu has been drawn whole
+  else c->cells->m_len_x = 0;
+
+  return c;
+}
+
+void
+Fl_Menu_Window::clear_cache()
+{
+  for (int i = 0; i < MENUCACHE_SLOTS; i++)
+  {
+    if (menucache_[i].cells) block_free(menucache_[i].cells);
+
+    memset(&menucache_[i], 0, sizeof(menucache));
+  }
+}
+
+// everything an item shows, and where it is in the array
+static unsigned long
+item_version(unsigned long h, const Fl_Menu_Item* m)
+{
+  h = h * 31 + (unsigned long)(size_t)m;
+  h = h * 31 + (unsigned long)m->flags;
+  h = h * 31 + (unsigned long)m->shortcut_;
+  h = h * 31 + (unsigned long)m->labeltype_;
+
+  for (const unsigned char* s = m->text; *s; s++) h = h * 31 + *s;
+
+  return h;
+}
+
 class menutitle : public Fl_Menu_Window
 {
     void draw();
@@ -180,6 +295,11 @@ class menuwindow : public Fl_Menu_Window
     int shortcutWidth;
     const Fl_Menu_Item* menu;
     const Fl_Menu_Item** table;
+    const Fl_Menu_Item** all;
+    int numall;
+    char search[64];
+    int nsearch;
+    unsigned long version;
     unsigned int offset_y;
     menuwindow(const Fl_Menu_Item* m, int X, int Y, int W, int H,
                const Fl_Menu_Item* picked, const Fl_Menu_Item* title,
@@ -189,6 +309,7 @@ class menuwindow : public Fl_Menu_Window
     int find_selected(int mx, int my);
     int titlex(int);
     void autoscroll(int);
+    bool filter(const char* text);
     void position(int x, int y);
     int is_inside(int x, int y);
 };
@@ -224,21 +345,21 @@ Fl_Menu_Item::draw(int x, int y, int w, int h, const Fl_Menu_* m,
 
   if (!fl_draw_shortcut) fl_draw_shortcut = 1;
 
-  enum Fl::foreground fcolor = m->skin_.menu_fcolor;
-  enum Fl::foreground hcolor = m->skin_.highlight_fcolor;
+  enum Fl::foreground fcolor = m->skin_->menu_fcolor;
+  enum Fl::foreground hcolor = m->skin_->highlight_fcolor;
 
   if (active())
   {
     if (selected)
     {
-      fcolor = m->skin_.highlight_fcolor;
+      fcolor = m->skin_->highlight_fcolor;
     }
   }
 
   else
   {
-    fcolor = m->skin_.disabled_fcolor;
-    hcolor = m->skin_.disabled_fcolor;
+    fcolor = m->skin_->disabled_fcolor;
+    hcolor = m->skin_->disabled_fcolor;
   }
 
   if ((FL_MENU_TOGGLE | FL_MENU_RADIO) & flags)
@@ -265,7 +386,7 @@ Fl_Menu_Item::draw(int x, int y, int w, int h, const Fl_Menu_* m,
   }
 
   l.draw(x, y, w, h, Fl_Label::FL_ALIGN_LEFT,
-         fcolor, m->skin_.menu_bcolor, hcolor);
+         fcolor, m->skin_->menu_bcolor, hcolor);
 
   fl_draw_shortcut = 0;
 
@@ -280,7 +401,9 @@ menutitle::menutitle(int X, int Y, int W, int H, const Fl_Menu_Item* L) :
   clear_border();
   set_menu_window();
   menu = L;
-  Fl_Widget::skin_.normal_fcolor = Fl_Widget::skin_.highlight_fcolor;
+  struct Fl::skin_widget skin = *Fl_Widget::skin_;
+  skin.normal_fcolor = skin.highlight_fcolor;
+  Fl_Widget::skin_ = Fl::skin_intern(skin);
 }
 
 menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
@@ -289,6 +412,11 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
   : Fl_Menu_Window(X, Y, Wp, Hp, 0)
 {
   offset_y = 0;
+  table = 0;
+  all = 0;
+  numall = 0;
+  search[0] = 0;
+  nsearch = 0;
   type(FL_MENU_WINDOW);
   int scr_x, scr_y, scr_w, scr_h;
   int tx = X, ty = Y;
@@ -306,6 +434,7 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
 
   drawn_selected = -1;
   selected = -1;
+  version = 0;
 
   numitems = 0;
   int j = 0;
@@ -314,10 +443,12 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
   {
     Fl_Menu_Item const* m1;
 
-    for (m1 = m; ; m1 = m1->next(), j++)
+    for (m1 = m; ; m1 = m1->next())
     {
       if (!m1->text) break;
 
+      version = item_version(version, m1);
+
       if (m1->visible())
       {
         numitems++;
@@ -326,22 +457,6 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
         {
           numitems++;
         }
-
-        if (picked)
-        {
-          if (m1 == picked)
-          {
-            selected = j;
-            picked = 0;
-          }
-
-          else if (m1 > picked)
-          {
-            selected = j - 1;
-            picked = 0;
-            Wp = Hp = 0;
-          }
-        }
       }
     }
 
@@ -349,13 +464,34 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
     {
       table = (const Fl_Menu_Item**)calloc(sizeof(Fl_Menu_Item*), numitems);
 
-      for (j = 0, m1 = m; ; m1 = m1->next(), j++)
+      // selected is a row of the table, or an item of a menu bar
+      int item = 0;
+      int prev = -1;
+
+      for (j = 0, m1 = m; ; m1 = m1->next(), j++, item++)
       {
         if (!m1->text) break;
 
         if (m1->visible())
         {
+          if (picked)
+          {
+            if (m1 == picked)
+            {
+              selected = menubar ? item : j;
+              picked = 0;
+            }
+
+            else if (m1 > picked)
+            {
+              selected = menubar ? item - 1 : prev;
+              picked = 0;
+              Wp = Hp = 0;
+            }
+          }
+
           table[j] = m1;
+          prev = j;
 
           if (FL_MENU_DIVIDER & m1->flags)
           {
@@ -383,8 +519,20 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
   if (t) Wtitle = t->measure(&Htitle, button) + 1;
 
   int W = 0;
+  menucache* cache = m ? menucache_find(menu, version, Fl_Widget::skin_) : 0;
 
-  if (m) for (; m->text; m = m->next())
+  if (cache)
+  {
+    W = cache->width;
+    hotKeysw = cache->keys_width;
+    hotModsw = cache->mods_width;
+  }
+
+  else if (m)
+  {
+    cache = menucache_take(menu, version, Fl_Widget::skin_);
+
+    for (; m->text; m = m->next())
     {
       int hh;
       int w1 = m->measure(&hh, button);
@@ -421,6 +569,11 @@ menuwindow::menuwindow(const Fl_Menu_Item* m, int X, int Y, int Wp, int Hp,
       }
     }
 
+    cache->width = W;
+    cache->keys_width = hotKeysw;
+    cache->mods_width = hotModsw;
+  }
+
   shortcutWidth = hotKeysw;
 
   if (selected >= 0 && !Wp) X -= W / 2;
@@ -516,6 +669,7 @@ menuwindow::~menuwindow()
   hide();
   delete title;
   free(table);
+  free(all);
 }
 
 void
@@ -534,32 +688,119 @@ menuwindow::autoscroll(int n)
 {
   unsigned int old_offset = offset_y;
 
-  do
+  if (n < (int)offset_y)
   {
+    offset_y = (n < 0) ? 0 : n;
+  }
 
-    if (n >= (int)offset_y && n < (int)(offset_y + h_ - 1))
-    {
-      break;
-    }
+  else if (n > (int)(offset_y + h_ - 1))
+  {
+    offset_y = n - (h_ - 1);
+  }
+
+  if (old_offset != offset_y)
+  {
+    damage(Fl_Widget::FL_DAMAGE_ALL);
+  }
+
+  return;
+}
+
+// case-insensitive search for text in a label, ignoring the '&' that
+// marks its shortcut
+static bool
+label_contains(const unsigned char* label, const char* text)
+{
+  for (; *label; label++)
+  {
+    const unsigned char* l = label;
+    const char* t = text;
 
-    if (n < (int)offset_y)
+    while (*t)
     {
-      for (; n < (int)offset_y; offset_y--);
+      if (*l == '&' && l[1])
+        l++;
 
-      break;
+      if (tolower(*l) != tolower((unsigned char)*t))
+        break;
+
+      l++;
+      t++;
     }
 
-    for (; n > (int)(offset_y + h_ - 1); offset_y++);
+    if (!*t) return true;
+  }
 
+  return false;
+}
+
+/*
+  Shows only the items whose labels contain text, or every row again
+  when text is empty.  A longer text only has to look at the rows shown
+  now.  Returns false, leaving the rows as they were, if nothing
+  matches.
+*/
+bool
+menuwindow::filter(const char* text)
+{
+  const Fl_Menu_Item** from;
+  int count;
+  int i;
+  int n = 0;
+
+  if (!all)
+  {
+    if (!*text) return true;
+
+    all = (const Fl_Menu_Item**)malloc(numitems * sizeof(Fl_Menu_Item*));
+
+    if (!all) return false;
+
+    memcpy(all, table, numitems * sizeof(Fl_Menu_Item*));
+    numall = numitems;
   }
-  while (0);
 
-  if (old_offset != offset_y)
+  if (nsearch && !strncmp(text, search, nsearch))
   {
-    damage(Fl_Widget::FL_DAMAGE_ALL);
+    from = table;
+    count = numitems;
   }
 
-  return;
+  else
+  {
+    from = all;
+    count = numall;
+  }
+
+  if (!*text)
+  {
+    memcpy(table, all, numall * sizeof(Fl_Menu_Item*));
+    numitems = numall;
+  }
+
+  else
+  {
+    for (i = 0; i < count; i++)
+    {
+      if (from[i] && label_contains(from[i]->text, text)) n++;
+    }
+
+    if (!n) return false;
+
+    for (n = 0, i = 0; i < count; i++)
+    {
+      if (from[i] && label_contains(from[i]->text, text)) table[n++] = from[i];
+    }
+
+    numitems = n;
+  }
+
+  strlcpy(search, text, sizeof(search));
+  nsearch = (int)strlen(search);
+  offset_y = 0;
+  selected = -1;
+  damage(Fl_Widget::FL_DAMAGE_ALL);
+  return true;
 }
 
 void
@@ -583,7 +824,7 @@ menuwindow::drawentry(
   if (m->submenu())
   {
     Fl::draw_putc((xx + ww - 2), yy, Fl::_skin_sym.right, 1,
-                  Fl_Widget::skin_.menu_fcolor, Fl_Widget::skin_.menu_bcolor);
+                  Fl_Widget::skin_->menu_fcolor, Fl_Widget::skin_->menu_bcolor);
   }
 
   else if (m->shortcut_)
@@ -602,9 +843,9 @@ menuwindow::drawentry(
         ww - shortcutWidth,
         hh,
         Fl_Label::FL_ALIGN_RIGHT,
-        Fl_Widget::skin_.menu_fcolor,
-        Fl_Widget::skin_.menu_bcolor,
-        Fl_Widget::skin_.highlight_fcolor);
+        Fl_Widget::skin_->menu_fcolor,
+        Fl_Widget::skin_->menu_bcolor,
+        Fl_Widget::skin_->highlight_fcolor);
 
       fl_draw(
         (unsigned char*)k,
@@ -613,9 +854,9 @@ menuwindow::drawentry(
         shortcutWidth,
         hh,
         Fl_Label::FL_ALIGN_LEFT,
-        Fl_Widget::skin_.menu_fcolor,
-        Fl_Widget::skin_.menu_bcolor,
-        Fl_Widget::skin_.highlight_fcolor);
+        Fl_Widget::skin_->menu_fcolor,
+        Fl_Widget::skin_->menu_bcolor,
+        Fl_Widget::skin_->highlight_fcolor);
 
       free(buf);
     }
@@ -629,18 +870,19 @@ menuwindow::drawentry(
         ww - 4,
         hh,
         Fl_Label::FL_ALIGN_RIGHT,
-        Fl_Widget::skin_.menu_fcolor,
-        Fl_Widget::skin_.menu_bcolor,
-        Fl_Widget::skin_.highlight_fcolor);
+        Fl_Widget::skin_->menu_fcolor,
+        Fl_Widget::skin_->menu_bcolor,
+        Fl_Widget::skin_->highlight_fcolor);
     }
   }
 
-  if (m->flags & FL_MENU_DIVIDER)
+  // a filtered menu has no rows left for the dividers
+  if ((m->flags & FL_MENU_DIVIDER) && !nsearch)
   {
     if ((yy + 1) < (int)h_)
     {
       Fl::draw_fill(xx, yy + 1, ww + 1, 1, Fl::_skin_sym.hline,
-                    Fl_Widget::skin_.menu_fcolor, Fl_Widget::skin_.menu_bcolor);
+                    Fl_Widget::skin_->menu_fcolor, Fl_Widget::skin_->menu_bcolor);
     }
   }
 
@@ -659,12 +901,28 @@ menuwindow::draw()
 {
   const Fl_Menu_Item* m;
 
-  Fl_Window_Driver::driver(this)->draw_begin();
+  Fl_Window_Driver* driver = Fl_Window_Driver::driver(this);
+  menucache* cache = 0;
 
-  if (damage() != FL_DAMAGE_CHILD)
+  driver->draw_begin();
+
+  // a whole, unfiltered submenu may be in the cache as last drawn
+  if (menu && itemheight && !nsearch && (damage() & FL_DAMAGE_ALL))
+  {
+    cache = menucache_find(menu, version, Fl_Widget::skin_);
+  }
+
+  if (cache && cache->cells && cache->cells_offset == offset_y &&
+      driver->restore_menu(cache->cells))
+  {
+    // only the highlighted row may differ
+    drawn_selected = cache->cells_selected;
+  }
+
+  else if (damage() != FL_DAMAGE_CHILD)
   {
     Fl::draw_fill(0, 0, w(), h(), 0x20,
-                  Fl_Widget::skin_.menu_fcolor, Fl_Widget::skin_.menu_bcolor);
+                  Fl_Widget::skin_->menu_fcolor, Fl_Widget::skin_->menu_bcolor);
 
     if (menu)
     {
@@ -695,9 +953,17 @@ menuwindow::draw()
       }
       while (1);
     }
+
+    drawn_selected = selected;
+
+    if (cache && cache->cells && driver->save_menu(cache->cells))
+    {
+      cache->cells_offset = offset_y;
+      cache->cells_selected = selected;
+    }
   }
 
-  else if (damage() & FL_DAMAGE_CHILD && selected != drawn_selected)
+  if (selected != drawn_selected)
   {
     if (-1 != drawn_selected)
     {
@@ -721,7 +987,7 @@ menuwindow::draw()
   }
 
   drawn_selected = selected;
-  Fl_Window_Driver::driver(this)->draw_end();
+  driver->draw_end();
 
   return;
 }
@@ -767,7 +1033,7 @@ menuwindow::find_selected(int mx, int my)
 
   if (mx < 0 || mx > (int)w_) return -1;
 
-  if (my < 0 || my >= numitems) return -1;
+  if (my < 0 || my + (int)offset_y >= numitems) return -1;
 
   return (my + offset_y);
 }
@@ -845,7 +1111,17 @@ static void
 setitem(int m, int n)
 {
   menustate& pp = *p;
-  pp.current_item = (n >= 0) ? pp.p[m]->menu->next(n) : 0;
+  menuwindow& mw = *(pp.p[m]);
+
+  if (n < 0)
+    pp.current_item = 0;
+
+  else if (mw.itemheight)
+    pp.current_item = (n < mw.numitems) ? mw.table[n] : 0;
+
+  else
+    pp.current_item = mw.menu->next(n);
+
   pp.menu_number = m;
   pp.item_number = n;
 }
@@ -913,6 +1189,63 @@ backward(int menu)
   return 0;
 }
 
+// selects the first active row from item on, looking the other way if
+// there is none
+static int
+jump(int menu, int item, int down)
+{
+  menustate& pp = *p;
+  menuwindow& m = *(pp.p[menu]);
+  int old_menu = pp.menu_number;
+  int old_item = pp.item_number;
+
+  if (item >= m.numitems) item = m.numitems - 1;
+
+  if (item < 0) item = 0;
+
+  pp.menu_number = menu;
+  pp.item_number = down ? item - 1 : item + 1;
+
+  if (down ? forward(menu) : backward(menu)) return 1;
+
+  pp.item_number = item;
+
+  if (down ? backward(menu) : forward(menu)) return 1;
+
+  pp.menu_number = old_menu;
+  pp.item_number = old_item;
+  return 0;
+}
+
+// narrows the rows of a menu to those matching text, keeping the
+// current item if it is still shown
+static int
+typeahead(int menu, const char* text)
+{
+  menustate& pp = *p;
+  menuwindow& m = *(pp.p[menu]);
+  int item;
+
+  if (!m.filter(text)) return 0;
+
+  if (pp.current_item && pp.menu_number == menu)
+  {
+    for (item = 0; item < m.numitems; item++)
+    {
+      if (m.table[item] == pp.current_item)
+      {
+        pp.item_number = item;
+        m.set_selected(item);
+        m.autoscroll(item);
+        return 1;
+      }
+    }
+  }
+
+  jump(menu, 0, 1);
+  return 1;
+}
+
 bool
 menuwindow::handle(Fl_Event const e)
 {
@@ -971,6 +1304,16 @@ menuwindow::handle_part1(Fl_Event const e)
       switch (Fl::event_key())
       {
         case FL_BackSpace:
+          if (pp.menu_number >= 0 && pp.p[pp.menu_number]->nsearch)
+          {
+            menuwindow& mw = *pp.p[pp.menu_number];
+            char text[sizeof(mw.search)];
+            strlcpy(text, mw.search, sizeof(text));
+            text[mw.nsearch - 1] = 0;
+            typeahead(pp.menu_number, text);
+            return 1;
+          }
+
         BACKTAB:
           if (!backward(pp.menu_number))
           {
@@ -1031,13 +1374,56 @@ menuwindow::handle_part1(Fl_Event const e)
 
           return 1;
 
+        case ' ':
+          // while filtering, a space is part of the typed text
+          if (pp.menu_number >= 0 && pp.p[pp.menu_number]->nsearch) break;
+
         case FL_Enter:
         case FL_KP_Enter:
-        case ' ':
           pp.state = DONE_STATE;
           return 1;
 
+        case FL_Home:
+        case FL_End:
+        case FL_Page_Up:
+        case FL_Page_Down:
+          if (pp.menu_number >= 0 && pp.p[pp.menu_number]->itemheight)
+          {
+            menuwindow& mw = *pp.p[pp.menu_number];
+            int item = pp.item_number < 0 ? 0 : pp.item_number;
+            int page = (int)mw.h() - 1;
+
+            switch (Fl::event_key())
+            {
+              case FL_Home:
+                jump(pp.menu_number, 0, 1);
+                break;
+
+              case FL_End:
+                jump(pp.menu_number, mw.numitems - 1, 0);
+                break;
+
+              case FL_Page_Up:
+                jump(pp.menu_number, item - page, 0);
+                break;
+
+              default:
+                jump(pp.menu_number, item + page, 1);
+                break;
+            }
+
+            return 1;
+          }
+
+          break;
+
         case FL_Escape:
+          if (pp.menu_number >= 0 && pp.p[pp.menu_number]->nsearch)
+          {
+            typeahead(pp.menu_number, "");
+            return 1;
+          }
+
           setitem(0, -1, 0);
           pp.state = DONE_STATE;
           return 1;
@@ -1047,12 +1433,45 @@ menuwindow::handle_part1(Fl_Event const e)
 
     case FL_SHORTCUT:
     {
+      // printable keys that are no item's shortcut filter the menu
+      int menu = pp.menu_number < 0 ? 0 : pp.menu_number;
+      menuwindow& cw = *(pp.p[menu]);
+      const char* key = (const char*)Fl::event_text();
+      int typing = cw.itemheight && key[0] && !key[1] &&
+                   (unsigned char)key[0] >= ' ' && key[0] != 127 &&
+                   !Fl::event_state(FL_CTRL | FL_ALT | FL_META);
+      char text[sizeof(cw.search)];
+
+      if (typing)
+      {
+        strlcpy(text, cw.search, sizeof(text));
+        strlcat(text, key, sizeof(text));
+
+        if (cw.nsearch)
+        {
+          typeahead(menu, text);
+          return 1;
+        }
+      }
+
       for (int mymenu = pp.nummenus; mymenu--;)
       {
         menuwindow& mw = *(pp.p[mymenu]);
         int item;
         const Fl_Menu_Item* m = mw.menu->find_shortcut(&item);
 
+        if (m && mw.itemheight)
+        {
+          // item counts entries; item_number is a row of the table,
+          // where dividers take rows and filtered entries have none
+          for (item = 0; item < mw.numitems; item++)
+          {
+            if (mw.table[item] == m) break;
+          }
+
+          if (item == mw.numitems) m = 0;
+        }
+
         if (m)
         {
           setitem(m, mymenu, item);
@@ -1062,6 +1481,12 @@ menuwindow::handle_part1(Fl_Event const e)
           return 1;
         }
       }
+
+      if (typing)
+      {
+        typeahead(menu, text);
+        return 1;
+      }
     }
     break;
 
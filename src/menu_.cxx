@@ -417,6 +417,7 @@ Fl_Menu_::Fl_Menu_(
   Fl_Widget(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label)
 {
   set_flag(SHORTCUT_LABEL);
+  update_label_shortcut();
   when(FL_WHEN_RELEASE_ALWAYS);
   value_ = menu_ = 0;
   alloc = 0;
@@ -435,6 +436,7 @@ Fl_Menu_::menu(const Fl_Menu_Item* m)
 {
   clear();
   value_ = menu_ = (Fl_Menu_Item*)m;
+  Fl::menu_shortcuts_changed(this);
 }
 
 void
@@ -480,6 +482,21 @@ Fl_Menu_::clear()
 
   menu_ = 0;
   value_ = 0;
+  Fl::menu_shortcuts_changed(this);
+}
+
+void
+Fl_Menu_::shortcut(int i, int s)
+{
+  menu_[i].shortcut(s);
+  Fl::menu_shortcuts_changed(this);
+}
+
+void
+Fl_Menu_::mode(int i, int fl)
+{
+  menu_[i].flags = fl;
+  Fl::menu_shortcuts_changed(this);
 }
 
 int
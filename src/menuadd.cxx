@@ -69,6 +69,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "menu_.h"
+#include "fl.h"
 #include "flstring.h"
 
 static Fl_Menu_Item* local_array = 0;
@@ -308,9 +309,334 @@ Fl_Menu_::insert(
 
   if (value_) value_ = menu_ + value_offset;
 
+  Fl::menu_shortcuts_changed(this);
+
   return r;
 }
 
+// Fl_Menu_::add_many() builds the menu as a tree first.  Each node
+// holds its finished item; a hash on (parent, label, submenu or not)
+// finds the submenu or item a path names in one probe, where add()
+// scans the level.
+struct menu_node
+{
+  Fl_Menu_Item item;
+  int parent;
+  int first;
+  int last;
+  int next;
+  int old;
+  int pos;
+};
+
+struct menu_build
+{
+  menu_node* nodes;
+  int count;
+  int alloc;
+  int* hash;
+  unsigned int mask;
+};
+
+static unsigned int
+node_hash(int parent, int submenu, const unsigned char* text)
+{
+  unsigned int h = 2166136261u;
+
+  h = (h ^ (unsigned int)parent) * 16777619u;
+  h = (h ^ (unsigned int)submenu) * 16777619u;
+
+  // compare() ignores the '&' of a shortcut, so the hash does too
+  for (; *text; text++)
+    if (*text != '&') h = (h ^ *text) * 16777619u;
+
+  return h;
+}
+
+static int
+node_find(const menu_build& b, int parent, int submenu,
+          const unsigned char* text)
+{
+  unsigned int i = node_hash(parent, submenu, text) & b.mask;
+
+  for (; b.hash[i] >= 0; i = (i + 1) & b.mask)
+  {
+    const menu_node& n = b.nodes[b.hash[i]];
+
+    if (n.parent == parent && !(n.item.flags & FL_SUBMENU) == !submenu
+        && !compare(text, n.item.text))
+      return b.hash[i];
+  }
+
+  return -1;
+}
+
+// the first item of a level with a label is the one add() would find
+static void
+node_hash_add(menu_build& b, int n)
+{
+  const menu_node& node = b.nodes[n];
+  int submenu = (node.item.flags & FL_SUBMENU) ? 1 : 0;
+
+  if (node_find(b, node.parent, submenu, node.item.text) >= 0) return;
+
+  unsigned int i = node_hash(node.parent, submenu, node.item.text) & b.mask;
+
+  while (b.hash[i] >= 0) i = (i + 1) & b.mask;
+
+  b.hash[i] = n;
+}
+
+static int
+node_add(menu_build& b, int parent, const Fl_Menu_Item& item)
+{
+  if (b.count == b.alloc)
+  {
+    int alloc = b.alloc ? 2 * b.alloc : 64;
+    menu_node* nodes = (menu_node*)realloc(b.nodes, alloc * sizeof(menu_node));
+
+    if (!nodes) return -1;
+
+    b.nodes = nodes;
+    b.alloc = alloc;
+  }
+
+  if (2 * (unsigned int)b.count >= b.mask)
+  {
+    unsigned int size = 2 * (b.mask + 1);
+    int* hash = (int*)malloc(size * sizeof(int));
+
+    if (!hash) return -1;
+
+    free(b.hash);
+    b.hash = hash;
+    b.mask = size - 1;
+
+    for (unsigned int i = 0; i < size; i++) hash[i] = -1;
+
+    for (int i = 1; i < b.count; i++) node_hash_add(b, i);
+  }
+
+  int n = b.count++;
+  menu_node& node = b.nodes[n];
+
+  node.item = item;
+  node.item.text = (unsigned char*)strdup((char const*)item.text);
+  node.parent = parent;
+  node.first = node.last = node.next = -1;
+  node.old = -1;
+  node.pos = -1;
+
+  if (!node.item.text)
+  {
+    b.count--;
+    return -1;
+  }
+
+  if (parent < 0) return n;
+
+  if (b.nodes[parent].last >= 0) b.nodes[b.nodes[parent].last].next = n;
+
+  else b.nodes[parent].first = n;
+
+  b.nodes[parent].last = n;
+  node_hash_add(b, n);
+  return n;
+}
+
+// adds the items of an existing menu level, returning the end of it
+static const Fl_Menu_Item*
+node_add_menu(menu_build& b, int parent, const Fl_Menu_Item* m,
+              const Fl_Menu_Item* base)
+{
+  while (m->text)
+  {
+    int n = node_add(b, parent, *m);
+
+    if (n < 0) return 0;
+
+    b.nodes[n].old = (int)(m - base);
+
+    if (m->flags & FL_SUBMENU)
+    {
+      m = node_add_menu(b, n, m + 1, base);
+
+      if (!m) return 0;
+    }
+
+    else m++;
+  }
+
+  return m + 1;
+}
+
+static Fl_Menu_Item*
+node_layout(menu_build& b, int parent, Fl_Menu_Item* out, Fl_Menu_Item* base)
+{
+  for (int n = b.nodes[parent].first; n >= 0; n = b.nodes[n].next)
+  {
+    b.nodes[n].pos = (int)(out - base);
+    *out++ = b.nodes[n].item;
+
+    if (b.nodes[n].item.flags & FL_SUBMENU)
+      out = node_layout(b, n, out, base) + 1;
+  }
+
+  return out;
+}
+
+// adds one entry to the tree the way Fl_Menu_Item::insert() adds it
+// to an array
+static int
+node_add_entry(menu_build& b, const Fl_Menu_Entry& e)
+{
+  Fl_Menu_Item item;
+  const unsigned char* mytext = e.label;
+  const unsigned char* p;
+  unsigned char* q;
+  unsigned char buf[1024];
+  const unsigned char* text;
+  int parent = 0;
+  int flags1 = 0;
+  int n;
+
+  memset(&item, 0, sizeof(item));
+
+  for (;;)
+  {
+    if (*mytext == '/')
+    {
+      text = mytext;
+      break;
+    }
+
+    if (*mytext == '_')
+    {
+      mytext++;
+      flags1 = FL_MENU_DIVIDER;
+    }
+
+    q = buf;
+
+    for (p = mytext; *p && *p != '/' && q < buf + sizeof(buf) - 1; *q++ = *p++)
+      if (*p == '\\' && p[1]) p++;
+
+    *q = 0;
+    text = buf;
+
+    if (*p != '/') break;
+
+    mytext = p + 1;
+    n = node_find(b, parent, 1, text);
+
+    if (n < 0)
+    {
+      item.text = text;
+      item.flags = FL_SUBMENU | flags1;
+      n = node_add(b, parent, item);
+
+      if (n < 0) return -1;
+    }
+
+    parent = n;
+    flags1 = 0;
+  }
+
+  n = (e.flags & FL_SUBMENU) ? -1 : node_find(b, parent, 0, text);
+
+  if (n < 0)
+  {
+    item.text = text;
+    item.flags = e.flags | flags1;
+    n = node_add(b, parent, item);
+
+    if (n < 0) return -1;
+  }
+
+  Fl_Menu_Item& m = b.nodes[n].item;
+  m.shortcut_ = e.shortcut;
+  m.callback_ = e.callback;
+  m.user_data_ = e.user_data;
+  m.flags = e.flags | flags1;
+  return n;
+}
+
+/**
+  Adds many items at once, as if add() were called for each entry in
+  turn, and returns the index of the last one or -1 if there are none
+  or memory runs out.
+  The items are sorted into their submenus before the menu array is
+  laid out, so this takes time linear in the size of the menu where
+  calling add() for each item takes quadratic time.
+*/
+int
+Fl_Menu_::add_many(const Fl_Menu_Entry* entries, int count)
+{
+  menu_build b;
+  Fl_Menu_Item root;
+  int last = -1;
+  int size = 1;
+  int i;
+
+  if (count <= 0) return -1;
+
+  memset(&b, 0, sizeof(b));
+  memset(&root, 0, sizeof(root));
+  root.text = (const unsigned char*)"";
+
+  b.mask = 63;
+  b.hash = (int*)malloc((b.mask + 1) * sizeof(int));
+
+  if (b.hash)
+  {
+    for (i = 0; i <= (int)b.mask; i++) b.hash[i] = -1;
+
+    last = node_add(b, -1, root);
+  }
+
+  if (last == 0 && menu_ && !node_add_menu(b, 0, menu_, menu_)) last = -1;
+
+  for (i = 0; last >= 0 && i < count; i++)
+    if (entries[i].label) last = node_add_entry(b, entries[i]);
+
+  if (last >= 0)
+  {
+    for (i = 1; i < b.count; i++)
+    {
+      size++;
+
+      if (b.nodes[i].item.flags & FL_SUBMENU) size++;
+    }
+
+    Fl_Menu_Item* array = new Fl_Menu_Item[size];
+    memset(array, 0, size * sizeof(Fl_Menu_Item));
+    node_layout(b, 0, array, array);
+
+    int value_index = value_ ? (int)(value_ - menu_) : -1;
+    const Fl_Menu_Item* value_item = 0;
+
+    for (i = 1; i < b.count; i++)
+      if (b.nodes[i].old >= 0 && b.nodes[i].old == value_index)
+        value_item = array + b.nodes[i].pos;
+
+    clear();
+    menu_ = array;
+    value_ = value_item;
+    alloc = 2;
+    last = b.nodes[last].pos;
+    Fl::menu_shortcuts_changed(this);
+
+    // the array now owns the texts of every node but the root
+    b.count = 1;
+  }
+
+  for (i = 0; i < b.count; i++) free((void*)b.nodes[i].item.text);
+
+  free(b.nodes);
+  free(b.hash);
+  return last;
+}
+
 int
 Fl_Menu_::add(const unsigned char* str)
 {
@@ -356,6 +682,7 @@ Fl_Menu_::replace(int i, const unsigned char* str)
   }
 
   menu_[i].text = str;
+  Fl::menu_shortcuts_changed(this);
 }
 
 
@@ -378,4 +705,5 @@ Fl_Menu_::remove(int i)
   }
 
   memmove(item, next_item, (menu_ + n - next_item)*sizeof(Fl_Menu_Item));
+  Fl::menu_shortcuts_changed(this);
 }
@@ -75,7 +75,7 @@ void
 Fl_Menu_Bar::draw()
 {
 
-  Fl::draw_fill(x_, y_, w_, h_, 0x20, skin_.menu_fcolor, skin_.menu_bcolor);
+  Fl::draw_fill(x_, y_, w_, h_, 0x20, skin_->menu_fcolor, skin_->menu_bcolor);
 
   if (!menu() || !menu()->text) return;
 
@@ -76,7 +76,7 @@ Fl_Value_Output::draw()
   unsigned char buf[128];
   format(buf);
   fl_draw(buf, x_, y_, w_, h_, Fl_Label::FL_ALIGN_LEFT,
-          skin_.normal_fcolor, skin_.normal_bcolor, skin_.normal_fcolor);
+          skin_->normal_fcolor, skin_->normal_bcolor, skin_->normal_fcolor);
 }
 
 bool
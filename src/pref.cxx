@@ -66,9 +66,13 @@
 //     License along with FLTK.  If not, see <http://www.gnu.org/licenses/>.
 //
 //
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#if !defined(__DOS__) && !defined(__NT__)
+#include <sys/mman.h>
+#endif
 #include "pref.h"
 #include "drvsys.h"
 #include "fl.h"
@@ -223,6 +227,9 @@ char
 Fl_Preferences::deleteAllGroups()
 {
   node->deleteAllChildren();
+
+  if ( rootNode ) rootNode->compact();
+
   return 1;
 }
 
@@ -254,6 +261,9 @@ char
 Fl_Preferences::deleteAllEntries()
 {
   node->deleteAllEntries();
+
+  if ( rootNode ) rootNode->compact();
+
   return 1;
 }
 
@@ -618,10 +628,36 @@ Fl_Preferences::getUserdataPath( char* path, int pathlen )
 void
 Fl_Preferences::flush()
 {
-  if ( rootNode && node->dirty() )
+  if ( rootNode && rootNode->dirty() )
     rootNode->write();
 }
 
+void
+Fl_Preferences::journal( char on )
+{
+  if ( rootNode )
+    rootNode->journal( on );
+}
+
+char
+Fl_Preferences::journal()
+{
+  return rootNode ? rootNode->journal() : 0;
+}
+
+void
+Fl_Preferences::binary( char on )
+{
+  if ( rootNode )
+    rootNode->binary( on );
+}
+
+char
+Fl_Preferences::binary()
+{
+  return rootNode ? rootNode->binary() : 0;
+}
+
 Fl_Preferences::Name::Name( unsigned int n )
 {
   data_ = (char*)malloc(20);
@@ -648,12 +684,173 @@ Fl_Preferences::Name::~Name()
 
 int Fl_Preferences::Node::lastEntrySet = -1;
 
+// FNV-1a over the first len characters of a name, continuing from h
+static unsigned int
+hashName( const char* name, size_t len, unsigned int h = 2166136261u )
+{
+  for ( size_t i = 0; i < len; i++ )
+  {
+    h ^= (unsigned char)name[i];
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static void
+bufferPut( Fl_Preferences::Buffer& b, const char* s, size_t len )
+{
+  if ( b.size + len > b.alloc )
+  {
+    size_t a = b.alloc ? b.alloc : 1024;
+
+    while ( a < b.size + len ) a *= 2;
+
+    b.data = (char*)realloc( b.data, a );
+    b.alloc = a;
+  }
+
+  memcpy( b.data + b.size, s, len );
+  b.size += len;
+}
+
+static void
+bufferPuts( Fl_Preferences::Buffer& b, const char* s )
+{
+  bufferPut( b, s, strlen( s ) );
+}
+
+static unsigned int
+get32( const unsigned char* p )
+{
+  return (unsigned int)p[0] | ( (unsigned int)p[1] << 8 ) |
+         ( (unsigned int)p[2] << 16 ) | ( (unsigned int)p[3] << 24 );
+}
+
+static void
+put32( Fl_Preferences::Buffer& b, unsigned int v )
+{
+  unsigned char p[4];
+
+  p[0] = (unsigned char)v;
+  p[1] = (unsigned char)( v >> 8 );
+  p[2] = (unsigned char)( v >> 16 );
+  p[3] = (unsigned char)( v >> 24 );
+  bufferPut( b, (const char*)p, 4 );
+}
+
+static int
+compareString( const void* a, const void* b )
+{
+  return strcmp( *(const char* const*)a, *(const char* const*)b );
+}
+
+// offset of s in a string table sorted by compareString()
+static unsigned int
+stringOffset( const char** str, const unsigned int* offset, int n,
+              const char* s )
+{
+  const char** at = (const char**)bsearch( &s, str, n, sizeof(char*),
+                                           compareString );
+  return offset[ at - str ];
+}
+
+// an entry as a "name:value" line, long values continued on '+' lines
+static void
+bufferEntry( Fl_Preferences::Buffer& b, const char* name, const char* src )
+{
+  size_t cnt;
+
+  bufferPuts( b, name );
+  bufferPut( b, ":", 1 );
+
+  for ( cnt = 0; cnt < 60; cnt++ )
+    if ( src[cnt] == 0 ) break;
+
+  bufferPut( b, src, cnt );
+  bufferPut( b, "\n", 1 );
+  src += cnt;
+
+  for (; *src;)
+  {
+    for ( cnt = 0; cnt < 80; cnt++ )
+      if ( src[cnt] == 0 ) break;
+
+    bufferPut( b, "+", 1 );
+    bufferPut( b, src, cnt );
+    bufferPut( b, "\n", 1 );
+    src += cnt;
+  }
+}
+
+// Maps the first size bytes of f read only, or reads them into the
+// heap; mapped tells which.  The mapping outlives f.  DOS cannot map
+// files, and Win32 could not replace or delete a file while it is
+// mapped, so another program's save would fail; both read instead.
+static unsigned char*
+mapImage( FILE* f, size_t size, char& mapped )
+{
+  unsigned char* p = 0L;
+
+#if !defined(__DOS__) && !defined(__NT__)
+  void* m = mmap( 0L, size, PROT_READ, MAP_PRIVATE, fileno( f ), 0 );
+
+  if ( m != MAP_FAILED )
+    p = (unsigned char*)m;
+
+#endif
+  mapped = ( p != 0L );
+
+  if ( !p )
+  {
+    p = (unsigned char*)malloc( size );
+    rewind( f );
+
+    if ( p && fread( p, 1, size, f ) != size )
+    {
+      free( p );
+      p = 0L;
+    }
+  }
+
+  return p;
+}
+
+static void
+unmapImage( unsigned char* p, size_t size, char mapped )
+{
+  if ( !mapped )
+  {
+    free( p );
+    return;
+  }
+
+#if !defined(__DOS__) && !defined(__NT__)
+  munmap( p, size );
+#else
+  (void)size;
+#endif
+}
+
 Fl_Preferences::RootNode::RootNode( Fl_Preferences* prefs, Root root,
                                     const char* vendor, const char* application )
   : prefs_(prefs),
     filename_(0L),
     vendor_(0L),
-    application_(0L)
+    application_(0L),
+    log_(),
+    logNode_(0L),
+    logSize_(0),
+    fileSize_(0),
+    fileHash_(0),
+    journal_(0),
+    loading_(0),
+    compact_(0),
+    binary_(0),
+    reformat_(0),
+    mapped_(0),
+    image_(0L),
+    imageSize_(0)
 {
 
   char* filename = Fl::system_driver()->preference_rootnode(prefs, root, vendor,
@@ -669,7 +866,20 @@ Fl_Preferences::RootNode::RootNode( Fl_Preferences* prefs, const char* path,
   : prefs_(prefs),
     filename_(0L),
     vendor_(0L),
-    application_(0L)
+    application_(0L),
+    log_(),
+    logNode_(0L),
+    logSize_(0),
+    fileSize_(0),
+    fileHash_(0),
+    journal_(0),
+    loading_(0),
+    compact_(0),
+    binary_(0),
+    reformat_(0),
+    mapped_(0),
+    image_(0L),
+    imageSize_(0)
 {
 
   if (!vendor)
@@ -698,13 +908,26 @@ Fl_Preferences::RootNode::RootNode( Fl_Preferences* prefs )
   : prefs_(prefs),
     filename_(0L),
     vendor_(0L),
-    application_(0L)
+    application_(0L),
+    log_(),
+    logNode_(0L),
+    logSize_(0),
+    fileSize_(0),
+    fileHash_(0),
+    journal_(0),
+    loading_(0),
+    compact_(0),
+    binary_(0),
+    reformat_(0),
+    mapped_(0),
+    image_(0L),
+    imageSize_(0)
 {
 }
 
 Fl_Preferences::RootNode::~RootNode()
 {
-  if ( prefs_->node->dirty() )
+  if ( dirty() )
     write();
 
   if ( filename_ )
@@ -725,34 +948,48 @@ Fl_Preferences::RootNode::~RootNode()
     application_ = 0L;
   }
 
+  if ( log_.data )
+  {
+    free( log_.data );
+    log_.data = 0L;
+  }
+
   delete prefs_->node;
   prefs_->node = 0L;
+
+  if ( image_ )
+  {
+    unmapImage( image_, imageSize_, mapped_ );
+    image_ = 0L;
+  }
 }
 
-int
-Fl_Preferences::RootNode::read()
+void
+Fl_Preferences::RootNode::parse( FILE* f, long stop )
 {
-  if (!filename_)
-    return -1;
-
   char buf[1024];
-  FILE* f = Fl::fopen( filename_, "rb" );
-
-  if ( !f )
-    return -1;
-
-  if (fgets( buf, 1024, f ) == 0) { /* ignore */ }
-
-  if (fgets( buf, 1024, f ) == 0) { /* ignore */ }
-
-  if (fgets( buf, 1024, f ) == 0) { /* ignore */ }
-
+  int skip = ( stop < 0 ) ? 3 : 0;
   Node* nd = prefs_->node;
 
   for (;;)
   {
+    if ( stop >= 0 && ftell( f ) >= stop ) break;
+
     if ( !fgets( buf, 1024, f ) ) break;
 
+    if ( stop < 0 )
+    {
+      size_t len = strlen( buf );
+      fileHash_ = hashName( buf, len, fileHash_ );
+      fileSize_ += (long)len;
+    }
+
+    if ( skip )
+    {
+      skip--;
+      continue;
+    }
+
     if ( buf[0] == '[' )
     {
       size_t end = strcspn( buf + 1, "]\n\r" );
@@ -771,6 +1008,17 @@ Fl_Preferences::RootNode::read()
       }
     }
 
+    else if ( stop >= 0 && buf[0] == ';' )
+    {
+      // journal commit mark
+    }
+
+    else if ( stop >= 0 && buf[0] == '-' && !strchr( buf, ':' ) )
+    {
+      buf[ strcspn( buf, "\n\r" ) ] = 0;
+      nd->deleteEntry( buf + 1 );
+    }
+
     else
     {
       size_t end = strcspn( buf, "\n\r" );
@@ -782,10 +1030,91 @@ Fl_Preferences::RootNode::read()
       }
     }
   }
+}
+
+// Applies the journal on top of the file just read.  Only records
+// up to the last commit mark are used, and only if the journal was
+// started against the file as it is now on disk.
+void
+Fl_Preferences::RootNode::replay( FILE* f )
+{
+  char buf[1024];
+  unsigned int base;
+  long start, end;
+
+  if ( !fgets( buf, 1024, f ) ) return;
+
+  if ( sscanf( buf, "; base: %x", &base ) != 1 || base != fileHash_ )
+  {
+    compact_ = 1;
+    return;
+  }
+
+  start = end = ftell( f );
+
+  while ( fgets( buf, 1024, f ) )
+  {
+    if ( buf[0] == ';' && strcspn( buf + 1, "\n\r" ) == 0 )
+      end = ftell( f );
+  }
+
+  if ( ftell( f ) != end )
+    compact_ = 1;
+
+  logSize_ = end;
+  fseek( f, start, SEEK_SET );
+  parse( f, end );
+}
+
+int
+Fl_Preferences::RootNode::read()
+{
+  if (!filename_)
+    return -1;
+
+  char path[ FL_PATH_MAX ];
+  FILE* f = Fl::fopen( filename_, "rb" );
+
+  if ( !f )
+  {
+    // left behind if the last save stopped between its two renames
+    snprintf( path, sizeof(path), "%s.tmp", filename_ );
+    f = Fl::fopen( path, "rb" );
+  }
+
+  loading_ = 1;
+  fileHash_ = hashName( "", 0 );
+  fileSize_ = 0;
+  prefs_->node->setRoot( this );
+
+  if ( f )
+  {
+    char magic[4];
+
+    if ( fread( magic, 1, 4, f ) == 4 && memcmp( magic, "FLPB", 4 ) == 0 )
+      readImage( f );
+
+    else
+    {
+      rewind( f );
+      parse( f, -1 );
+    }
+
+    fclose( f );
+  }
+
+  snprintf( path, sizeof(path), "%s.jnl", filename_ );
+  FILE* j = Fl::fopen( path, "rb" );
+
+  if ( j )
+  {
+    replay( j );
+    fclose( j );
+  }
 
-  fclose( f );
+  loading_ = 0;
   prefs_->node->clearDirtyFlags();
-  return 0;
+  return f ? 0 : -1;
 }
 
 int
@@ -794,17 +1123,111 @@ Fl_Preferences::RootNode::write()
   if (!filename_)
     return -1;
 
+  if ( journal_ && !compact_ && !reformat_ &&
+       logSize_ + (long)log_.size <= fileSize_ + JOURNAL_SLACK )
+    return writeLog();
+
+  return writeFile();
+}
+
+// Writes the whole tree to a temporary file in one write and renames
+// it over the old file, so a crash leaves either the old or the new
+// file but never a partial one.  Any journal is folded in and removed.
+int
+Fl_Preferences::RootNode::writeFile()
+{
+  char path[ FL_PATH_MAX ];
+  Buffer b = { 0, 0, 0 };
+  FILE* f;
+  int ok;
+
+  if ( binary_ )
+    writeImage( b );
+
+  else
+  {
+    bufferPuts( b, "; FLTK preferences file format 1.0\n; vendor: " );
+    bufferPuts( b, vendor_ );
+    bufferPuts( b, "\n; application: " );
+    bufferPuts( b, application_ );
+    bufferPuts( b, "\n" );
+    prefs_->node->write( b );
+  }
+
+  // every group has been loaded to write it out
+  if ( image_ )
+  {
+    unmapImage( image_, imageSize_, mapped_ );
+    image_ = 0L;
+    imageSize_ = 0;
+  }
+
   Fl::make_path_for_file(filename_);
-  FILE* f = Fl::fopen( filename_, "wb" );
+  snprintf( path, sizeof(path), "%s.tmp", filename_ );
+  f = Fl::fopen( path, "wb" );
 
   if ( !f )
+  {
+    // no room for the extra extension (8.3 names): write in place
+    path[0] = 0;
+    f = Fl::fopen( filename_, "wb" );
+  }
+
+  if ( !f )
+  {
+    free( b.data );
     return -1;
+  }
 
-  fprintf( f, "; FLTK preferences file format 1.0\n" );
-  fprintf( f, "; vendor: %s\n", vendor_ );
-  fprintf( f, "; application: %s\n", application_ );
-  prefs_->node->write( f );
-  fclose( f );
+  setvbuf( f, 0, _IONBF, 0 );
+  ok = ( fwrite( b.data, 1, b.size, f ) == b.size );
+  ok = ( fclose( f ) == 0 ) && ok;
+
+  if ( ok && path[0] && Fl::rename( path, filename_ ) != 0 )
+  {
+    ok = 0;
+#if defined(__DOS__) || defined(__NT__)
+
+    // rename() does not replace an existing file here
+    if ( errno == EEXIST || errno == EACCES )
+    {
+      Fl::unlink( filename_ );
+      ok = ( Fl::rename( path, filename_ ) == 0 );
+
+      // the temporary file is all that is left, and read() falls back to it
+      if ( !ok )
+        path[0] = 0;
+    }
+
+#endif
+  }
+
+  if ( !ok && path[0] )
+    Fl::unlink( path );
+
+  if ( !ok )
+  {
+    free( b.data );
+    return -1;
+  }
+
+  if ( binary_ )
+    fileHash_ = get32( (const unsigned char*)b.data + 8 );
+
+  else
+    fileHash_ = hashName( b.data, b.size );
+
+  fileSize_ = (long)b.size;
+  free( b.data );
+
+  snprintf( path, sizeof(path), "%s.jnl", filename_ );
+  Fl::unlink( path );
+  log_.size = 0;
+  logNode_ = 0L;
+  logSize_ = 0;
+  compact_ = 0;
+  reformat_ = 0;
+  prefs_->node->clearDirtyFlags();
 
   if (Fl::system_driver()->preferences_need_protection_check())
   {
@@ -829,6 +1252,353 @@ Fl_Preferences::RootNode::write()
   return 0;
 }
 
+// Appends the changes logged since the last save to the journal,
+// closed by a commit mark.  The journal is folded back into the file
+// once it grows past the size of the file itself.
+int
+Fl_Preferences::RootNode::writeLog()
+{
+  char path[ FL_PATH_MAX ];
+  FILE* f;
+  int ok;
+
+  if ( log_.size )
+  {
+    Fl::make_path_for_file(filename_);
+    snprintf( path, sizeof(path), "%s.jnl", filename_ );
+    f = Fl::fopen( path, logSize_ ? "ab" : "wb" );
+
+    if ( !f )
+      return writeFile();
+
+    bufferPut( log_, ";\n", 2 );
+    setvbuf( f, 0, _IONBF, 0 );
+    ok = ( fwrite( log_.data, 1, log_.size, f ) == log_.size );
+    ok = ( fclose( f ) == 0 ) && ok;
+
+    if ( !ok )
+    {
+      compact_ = 1;
+      return writeFile();
+    }
+
+    logSize_ += (long)log_.size;
+    log_.size = 0;
+    logNode_ = 0L;
+  }
+
+  prefs_->node->clearDirtyFlags();
+  return 0;
+}
+
+/*
+  The binary format is a node directory over a sorted string table,
+  all numbers 32 bit little endian:
+
+    header   "FLPB", version, hash of what follows, nodes, entries,
+             size of the string table
+    nodes    name, first child, children, first entry, entries
+    entries  name, value (0xffffffff for none)
+    strings  each string once, NUL terminated, in strcmp() order
+
+  Nodes are stored breadth first, so the children of a node are
+  adjacent.  The file is mapped in one piece, and a group becomes a
+  Node with its entries only when it is first looked at, so only the
+  pages of the groups used are ever read.
+*/
+int
+Fl_Preferences::RootNode::readImage( FILE* f )
+{
+  long size;
+  unsigned char* p;
+  char mapped;
+
+  if ( fseek( f, 0, SEEK_END ) != 0 )
+    return -1;
+
+  size = ftell( f );
+
+  if ( size < IMAGE_HEADER )
+    return -1;
+
+  p = mapImage( f, (size_t)size, mapped );
+
+  if ( !p )
+    return -1;
+
+  unsigned int nNode = get32( p + 12 );
+  unsigned int nEntry = get32( p + 16 );
+  unsigned int nString = get32( p + 20 );
+  unsigned long rest = (unsigned long)size - IMAGE_HEADER;
+  int ok = ( get32( p + 4 ) == 1 && nNode >= 1 && nNode <= rest / IMAGE_NODE );
+
+  if ( ok )
+  {
+    rest -= (unsigned long)nNode * IMAGE_NODE;
+    ok = ( nEntry <= rest / IMAGE_ENTRY );
+  }
+
+  if ( ok )
+  {
+    rest -= (unsigned long)nEntry * IMAGE_ENTRY;
+    ok = ( nString == rest && nString && p[ size - 1 ] == 0 );
+  }
+
+  if ( !ok )
+  {
+    unmapImage( p, (size_t)size, mapped );
+    return -1;
+  }
+
+  image_ = p;
+  imageSize_ = (size_t)size;
+  mapped_ = mapped;
+  fileHash_ = get32( p + 8 );
+  fileSize_ = size;
+  binary_ = 1;
+  prefs_->node->setLazy( 0 );
+  return 0;
+}
+
+// Turns record rec of the image into the entries and (still unloaded)
+// child groups of nd.
+void
+Fl_Preferences::RootNode::load( Node* nd, int rec )
+{
+  if ( !image_ || rec < 0 ) return;
+
+  const unsigned char* p = image_;
+  unsigned int nNode = get32( p + 12 );
+  unsigned int nEntry = get32( p + 16 );
+  unsigned int nString = get32( p + 20 );
+  const unsigned char* node = p + IMAGE_HEADER;
+  const unsigned char* entry = node + nNode * IMAGE_NODE;
+  const char* str = (const char*)( entry + nEntry * IMAGE_ENTRY );
+
+  if ( (unsigned int)rec >= nNode ) return;
+
+  const unsigned char* r = node + rec * IMAGE_NODE;
+  unsigned int first = get32( r + 4 ), n = get32( r + 8 );
+  unsigned int firstEntry = get32( r + 12 ), ne = get32( r + 16 );
+  unsigned int i;
+  char was = loading_;
+
+  loading_ = 1;
+
+  if ( firstEntry <= nEntry && ne <= nEntry - firstEntry )
+  {
+    for ( i = 0; i < ne; i++ )
+    {
+      const unsigned char* e = entry + ( firstEntry + i ) * IMAGE_ENTRY;
+      unsigned int name = get32( e ), value = get32( e + 4 );
+
+      if ( name < nString )
+        nd->set( str + name, value < nString ? str + value : 0 );
+    }
+  }
+
+  // a child always comes after its parent, which rules out loops
+  if ( first > (unsigned int)rec && first <= nNode && n <= nNode - first )
+  {
+    for ( i = 0; i < n; i++ )
+    {
+      unsigned int name = get32( node + ( first + i ) * IMAGE_NODE );
+
+      if ( name < nString )
+      {
+        Node* c = new Node( str + name );
+        c->setParent( nd );
+        c->setLazy( first + i );
+      }
+    }
+  }
+
+  loading_ = was;
+}
+
+void
+Fl_Preferences::RootNode::writeImage( Buffer& b )
+{
+  Node** node;
+  const char** str;
+  unsigned int* offset;
+  int nNode = 1, aNode = 64, nEntry = 0, nString = 0, nUnique = 0;
+  int i, j;
+  unsigned int size = 0, next = 1, nextEntry = 0;
+
+  // the nodes, breadth first
+  node = (Node**)malloc( aNode * sizeof(Node*) );
+  node[0] = prefs_->node;
+
+  for ( i = 0; i < nNode; i++ )
+  {
+    int n = node[i]->nChildren();
+
+    if ( nNode + n > aNode )
+    {
+      while ( nNode + n > aNode ) aNode *= 2;
+
+      node = (Node**)realloc( node, aNode * sizeof(Node*) );
+    }
+
+    for ( j = 0; j < n; j++ )
+      node[ nNode++ ] = node[i]->childNode( j );
+
+    nEntry += node[i]->nEntry();
+  }
+
+  // the string table
+  str = (const char**)malloc( ( nNode + 2 * nEntry ) * sizeof(char*) );
+
+  for ( i = 0; i < nNode; i++ )
+  {
+    str[ nString++ ] = node[i]->name();
+
+    for ( j = 0; j < node[i]->nEntry(); j++ )
+    {
+      Entry& e = node[i]->entry( j );
+      str[ nString++ ] = e.name;
+
+      if ( e.value ) str[ nString++ ] = e.value;
+    }
+  }
+
+  qsort( str, nString, sizeof(char*), compareString );
+
+  for ( i = 0; i < nString; i++ )
+    if ( !nUnique || strcmp( str[ nUnique - 1 ], str[i] ) != 0 )
+      str[ nUnique++ ] = str[i];
+
+  offset = (unsigned int*)malloc( ( nUnique + 1 ) * sizeof(unsigned int) );
+
+  for ( i = 0; i < nUnique; i++ )
+  {
+    offset[i] = size;
+    size += (unsigned int)strlen( str[i] ) + 1;
+  }
+
+  bufferPut( b, "FLPB", 4 );
+  put32( b, 1 );
+  put32( b, 0 );
+  put32( b, nNode );
+  put32( b, nEntry );
+  put32( b, size );
+
+  for ( i = 0; i < nNode; i++ )
+  {
+    const char* name = node[i]->name();
+    int n = node[i]->nChildren();
+    int ne = node[i]->nEntry();
+
+    put32( b, stringOffset( str, offset, nUnique, name ) );
+    put32( b, next );
+    put32( b, n );
+    put32( b, nextEntry );
+    put32( b, ne );
+    next += n;
+    nextEntry += ne;
+  }
+
+  for ( i = 0; i < nNode; i++ )
+  {
+    for ( j = 0; j < node[i]->nEntry(); j++ )
+    {
+      Entry& e = node[i]->entry( j );
+      put32( b, stringOffset( str, offset, nUnique, e.name ) );
+      put32( b, e.value ? stringOffset( str, offset, nUnique, e.value )
+             : 0xffffffffu );
+    }
+  }
+
+  for ( i = 0; i < nUnique; i++ )
+    bufferPut( b, str[i], strlen( str[i] ) + 1 );
+
+  unsigned int h = hashName( b.data + IMAGE_HEADER, b.size - IMAGE_HEADER );
+  b.data[8] = (char)h;
+  b.data[9] = (char)( h >> 8 );
+  b.data[10] = (char)( h >> 16 );
+  b.data[11] = (char)( h >> 24 );
+
+  free( offset );
+  free( str );
+  free( node );
+}
+
+void
+Fl_Preferences::RootNode::binary( char on )
+{
+  if ( ( on ? 1 : 0 ) != binary_ )
+  {
+    binary_ = on ? 1 : 0;
+    reformat_ = 1;
+  }
+}
+
+char
+Fl_Preferences::RootNode::dirty()
+{
+  return reformat_ || prefs_->node->dirty();
+}
+
+void
+Fl_Preferences::RootNode::journal( char on )
+{
+  // changes made before now are not in the log
+  if ( on && !journal_ && prefs_->node->dirty() )
+    compact_ = 1;
+
+  journal_ = on ? 1 : 0;
+}
+
+void
+Fl_Preferences::RootNode::logGroup( Node* nd )
+{
+  if ( !journal_ || loading_ || compact_ || !filename_ ) return;
+
+  if ( !log_.size && !logSize_ )
+  {
+    char buf[32];
+    sprintf( buf, "; base: %08x\n", fileHash_ );
+    bufferPuts( log_, buf );
+  }
+
+  if ( nd != logNode_ )
+  {
+    bufferPut( log_, "[", 1 );
+    bufferPuts( log_, nd->path() );
+    bufferPut( log_, "]\n", 2 );
+    logNode_ = nd;
+  }
+}
+
+void
+Fl_Preferences::RootNode::logEntry( Node* nd, const char* name,
+                                    const char* value )
+{
+  if ( !journal_ || loading_ || compact_ || !filename_ ) return;
+
+  logGroup( nd );
+
+  if ( value )
+    bufferEntry( log_, name, value );
+
+  else
+  {
+    bufferPut( log_, "-", 1 );
+    bufferPuts( log_, name );
+    bufferPut( log_, "\n", 1 );
+  }
+}
+
+// Changes the journal cannot express; the next save rewrites the file.
+void
+Fl_Preferences::RootNode::compact()
+{
+  compact_ = 1;
+  log_.size = 0;
+  logNode_ = 0L;
+}
+
 char
 Fl_Preferences::RootNode::getPath( char* path, int pathlen )
 {
@@ -904,6 +1674,11 @@ Fl_Preferences::Node::Node( const char* path )
   indexed_ = 0;
   index_ = 0;
   nIndex_ = NIndex_ = 0;
+  entryHash_ = 0;
+  NEntryHash_ = 0;
+  childHash_ = 0;
+  nChildHash_ = NChildHash_ = 0;
+  lazy_ = -1;
 }
 
 void
@@ -911,6 +1686,8 @@ Fl_Preferences::Node::deleteAllChildren()
 {
   Node* nx;
 
+  load();
+
   for ( Node* nd = child_; nd; nd = nx )
   {
     nx = nd->next_;
@@ -920,11 +1697,14 @@ Fl_Preferences::Node::deleteAllChildren()
   child_ = 0L;
   dirty_ = 1;
   updateIndex();
+  deleteChildHash();
 }
 
 void
 Fl_Preferences::Node::deleteAllEntries()
 {
+  load();
+
   if ( entry_ )
   {
     for ( int i = 0; i < nEntry_; i++ )
@@ -948,11 +1728,19 @@ Fl_Preferences::Node::deleteAllEntries()
     NEntry_ = 0;
   }
 
+  if ( entryHash_ )
+  {
+    free( entryHash_ );
+    entryHash_ = 0L;
+    NEntryHash_ = 0;
+  }
+
   dirty_ = 1;
 }
 
 Fl_Preferences::Node::~Node()
 {
+  lazy_ = -1;
   deleteAllChildren();
   deleteAllEntries();
   deleteIndex();
@@ -994,60 +1782,62 @@ Fl_Preferences::Node::clearDirtyFlags()
   }
 }
 
-int
-Fl_Preferences::Node::write( FILE* f )
+void
+Fl_Preferences::Node::write( Buffer& b )
 {
-  if ( next_ ) next_->write( f );
+  load();
+
+  if ( next_ ) next_->write( b );
 
-  fprintf( f, "\n[%s]\n\n", path_ );
+  bufferPuts( b, "\n[" );
+  bufferPuts( b, path_ );
+  bufferPuts( b, "]\n\n" );
 
   for ( int i = 0; i < nEntry_; i++ )
   {
-    char* src = entry_[i].value;
+    if ( entry_[i].value )
+      bufferEntry( b, entry_[i].name, entry_[i].value );
 
-    if ( src )
+    else
     {
-      fprintf( f, "%s:", entry_[i].name );
-      size_t cnt, written = 0;
-
-      for ( cnt = 0; cnt < 60; cnt++ )
-        if ( src[cnt] == 0 ) break;
-
-      written += fwrite( src, cnt, 1, f );
-      fprintf( f, "\n" );
-      src += cnt;
-
-      for (; *src;)
-      {
-        for ( cnt = 0; cnt < 80; cnt++ )
-          if ( src[cnt] == 0 ) break;
-
-        fputc( '+', f );
-        written += fwrite( src, cnt, 1, f );
-        fputc( '\n', f );
-        src += cnt;
-      }
+      bufferPuts( b, entry_[i].name );
+      bufferPut( b, "\n", 1 );
     }
-
-    else
-      fprintf( f, "%s\n", entry_[i].name );
   }
 
-  if ( child_ ) child_->write( f );
-
-  dirty_ = 0;
-  return 0;
+  if ( child_ ) child_->write( b );
 }
 
 void
 Fl_Preferences::Node::setParent( Node* pn )
 {
+  pn->load();
   parent_ = pn;
   next_ = pn->child_;
   pn->child_ = this;
   sprintf( nameBuffer, "%s/%s", pn->path_, path_ );
   free( path_ );
   path_ = strdup( nameBuffer );
+  pn->hashChild( this );
+}
+
+void
+Fl_Preferences::Node::loadLazy()
+{
+  RootNode* r = findRoot();
+  int rec = lazy_;
+  char dirt = dirty_;
+  char name[ sizeof(nameBuffer) ];
+
+  // callers may be holding a name or value in nameBuffer, which
+  // setParent() overwrites for every group loaded
+  memcpy( name, nameBuffer, sizeof(nameBuffer) );
+  lazy_ = -1;
+
+  if ( r ) r->load( this, rec );
+
+  memcpy( nameBuffer, name, sizeof(nameBuffer) );
+  dirty_ = dirt;
 }
 
 Fl_Preferences::RootNode*
@@ -1081,24 +1871,27 @@ Fl_Preferences::Node::addChild( const char* path )
 void
 Fl_Preferences::Node::set( const char* name, const char* value )
 {
-  for ( int i = 0; i < nEntry_; i++ )
+  int i = getEntry( name );
+
+  if ( i >= 0 )
   {
-    if ( strcmp( name, entry_[i].name ) == 0 )
+    if ( !value ) return;
+
+    if ( strcmp( value, entry_[i].value ) != 0 )
     {
-      if ( !value ) return;
+      if ( entry_[i].value )
+        free( entry_[i].value );
 
-      if ( strcmp( value, entry_[i].value ) != 0 )
-      {
-        if ( entry_[i].value )
-          free( entry_[i].value );
+      entry_[i].value = strdup( value );
+      dirty_ = 1;
 
-        entry_[i].value = strdup( value );
-        dirty_ = 1;
-      }
+      RootNode* r = findRoot();
 
-      lastEntrySet = i;
-      return;
+      if ( r ) r->logEntry( this, name, value );
     }
+
+    lastEntrySet = i;
+    return;
   }
 
   if ( NEntry_ == nEntry_ )
@@ -1111,7 +1904,15 @@ Fl_Preferences::Node::set( const char* name, const char* value )
   entry_[ nEntry_ ].value = value ? strdup( value ) : 0;
   lastEntrySet = nEntry_;
   nEntry_++;
+  hashEntry( nEntry_ - 1 );
   dirty_ = 1;
+
+  if ( value )
+  {
+    RootNode* r = findRoot();
+
+    if ( r ) r->logEntry( this, name, value );
+  }
 }
 
 void
@@ -1170,8 +1971,17 @@ Fl_Preferences::Node::get( const char* name )
 int
 Fl_Preferences::Node::getEntry( const char* name )
 {
-  for ( int i = 0; i < nEntry_; i++ )
+  load();
+
+  if ( !entryHash_ ) return -1;
+
+  unsigned int mask = NEntryHash_ - 1;
+  unsigned int h = hashName( name, strlen( name ) ) & mask;
+
+  for ( ; entryHash_[h]; h = ( h + 1 ) & mask )
   {
+    int i = entryHash_[h] - 1;
+
     if ( strcmp( name, entry_[i].name ) == 0 )
     {
       return i;
@@ -1188,9 +1998,19 @@ Fl_Preferences::Node::deleteEntry( const char* name )
 
   if ( ix == -1 ) return 0;
 
+  free( entry_[ix].name );
+
+  if ( entry_[ix].value ) free( entry_[ix].value );
+
   memmove( entry_ + ix, entry_ + ix + 1, (nEntry_ - ix - 1) * sizeof(Entry) );
   nEntry_--;
+  rehashEntries();
   dirty_ = 1;
+
+  RootNode* r = findRoot();
+
+  if ( r ) r->logEntry( this, name, 0 );
+
   return 1;
 }
 
@@ -1206,17 +2026,11 @@ Fl_Preferences::Node::find( const char* path )
 
     if ( path[ len ] == '/' )
     {
-      Node* nd;
-
-      for ( nd = child_; nd; nd = nd->next_ )
-      {
-        Node* nn = nd->find( path );
-
-        if ( nn ) return nn;
-      }
-
       const char* s = path + len + 1;
       const char* e = strchr( s, '/' );
+      Node* nd = findChild( s, e ? (size_t)( e - s ) : strlen( s ) );
+
+      if ( nd ) return nd->find( path );
 
       if (e) strlcpy( nameBuffer, s, e - s + 1 );
 
@@ -1225,6 +2039,11 @@ Fl_Preferences::Node::find( const char* path )
       nd = new Node( nameBuffer );
       nd->setParent( this );
       dirty_ = 1;
+
+      RootNode* r = findRoot();
+
+      if ( r ) r->logGroup( nd );
+
       return nd->find( path );
     }
   }
@@ -1275,14 +2094,11 @@ Fl_Preferences::Node::search( const char* path, int offset )
 
     if ( len <= 0 || path[ len ] == '/' )
     {
-      for ( Node* nd = child_; nd; nd = nd->next_ )
-      {
-        Node* nn = nd->search( path, offset );
-
-        if ( nn ) return nn;
-      }
+      const char* s = ( len > 0 ) ? path + len + 1 : path;
+      const char* e = strchr( s, '/' );
+      Node* nd = findChild( s, e ? (size_t)( e - s ) : strlen( s ) );
 
-      return 0;
+      return nd ? nd->search( path, offset ) : 0;
     }
   }
 
@@ -1292,6 +2108,8 @@ Fl_Preferences::Node::search( const char* path, int offset )
 int
 Fl_Preferences::Node::nChildren()
 {
+  load();
+
   if (indexed_)
   {
     return nIndex_;
@@ -1388,6 +2206,11 @@ Fl_Preferences::Node::remove()
 
     parent()->dirty_ = 1;
     parent()->updateIndex();
+    parent()->deleteChildHash();
+
+    RootNode* r = findRoot();
+
+    if ( r ) r->compact();
   }
 
   delete this;
@@ -1397,6 +2220,8 @@ Fl_Preferences::Node::remove()
 void
 Fl_Preferences::Node::createIndex()
 {
+  load();
+
   if (indexed_) return;
 
   int n = nChildren();
@@ -1433,6 +2258,151 @@ Fl_Preferences::Node::deleteIndex()
   NIndex_ = nIndex_ = 0;
   index_ = 0;
   indexed_ = 0;
+  deleteChildHash();
+}
+
+/*
+  Entry names and child group names are found through open addressing
+  tables.  The entry table holds an entry index + 1 per slot, 0 being a
+  free slot; the child table holds the child node.  Both are kept at no
+  more than half full.
+*/
+void
+Fl_Preferences::Node::hashEntry( int ix )
+{
+  if ( 2 * nEntry_ > NEntryHash_ )
+  {
+    rehashEntries();
+    return;
+  }
+
+  unsigned int mask = NEntryHash_ - 1;
+  unsigned int h = hashName( entry_[ix].name, strlen( entry_[ix].name ) ) & mask;
+
+  while ( entryHash_[h] ) h = ( h + 1 ) & mask;
+
+  entryHash_[h] = ix + 1;
+}
+
+void
+Fl_Preferences::Node::rehashEntries()
+{
+  int n = 16;
+
+  while ( n < 2 * nEntry_ ) n *= 2;
+
+  if ( n != NEntryHash_ )
+  {
+    free( entryHash_ );
+    entryHash_ = (int*)malloc( n * sizeof(int) );
+    NEntryHash_ = n;
+  }
+
+  memset( entryHash_, 0, n * sizeof(int) );
+
+  unsigned int mask = n - 1;
+
+  for ( int i = 0; i < nEntry_; i++ )
+  {
+    unsigned int h = hashName( entry_[i].name, strlen( entry_[i].name ) ) & mask;
+
+    while ( entryHash_[h] ) h = ( h + 1 ) & mask;
+
+    entryHash_[h] = i + 1;
+  }
+}
+
+void
+Fl_Preferences::Node::hashChild( Node* nd )
+{
+  if ( !childHash_ ) return; // built on the first lookup
+
+  nChildHash_++;
+
+  if ( 2 * nChildHash_ > NChildHash_ )
+  {
+    rehashChildren();
+    return;
+  }
+
+  const char* name = nd->name();
+  unsigned int mask = NChildHash_ - 1;
+  unsigned int h = hashName( name, strlen( name ) ) & mask;
+
+  while ( childHash_[h] ) h = ( h + 1 ) & mask;
+
+  childHash_[h] = nd;
+}
+
+void
+Fl_Preferences::Node::rehashChildren()
+{
+  int cnt = 0;
+  Node* nd;
+
+  for ( nd = child_; nd; nd = nd->next_ ) cnt++;
+
+  int n = 16;
+
+  while ( n < 2 * cnt ) n *= 2;
+
+  if ( n != NChildHash_ )
+  {
+    free( childHash_ );
+    childHash_ = (Node**)malloc( n * sizeof(Node*) );
+    NChildHash_ = n;
+  }
+
+  memset( childHash_, 0, n * sizeof(Node*) );
+
+  unsigned int mask = n - 1;
+
+  // the newest child is first in the list and wins a duplicate name,
+  // as it did when the list was scanned
+  for ( nd = child_; nd; nd = nd->next_ )
+  {
+    const char* name = nd->name();
+    unsigned int h = hashName( name, strlen( name ) ) & mask;
+
+    while ( childHash_[h] && strcmp( childHash_[h]->name(), name ) != 0 )
+      h = ( h + 1 ) & mask;
+
+    if ( !childHash_[h] ) childHash_[h] = nd;
+  }
+
+  nChildHash_ = cnt;
+}
+
+void
+Fl_Preferences::Node::deleteChildHash()
+{
+  if ( childHash_ ) free( childHash_ );
+
+  childHash_ = 0;
+  nChildHash_ = NChildHash_ = 0;
+}
+
+Fl_Preferences::Node*
+Fl_Preferences::Node::findChild( const char* name, size_t len )
+{
+  load();
+
+  if ( !child_ ) return 0;
+
+  if ( !childHash_ ) rehashChildren();
+
+  unsigned int mask = NChildHash_ - 1;
+  unsigned int h = hashName( name, len ) & mask;
+
+  for ( ; childHash_[h]; h = ( h + 1 ) & mask )
+  {
+    const char* cn = childHash_[h]->name();
+
+    if ( strncmp( cn, name, len ) == 0 && cn[len] == 0 )
+      return childHash_[h];
+  }
+
+  return 0;
 }
 
 #if 0
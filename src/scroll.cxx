@@ -118,14 +118,7 @@ Fl_Scroll::draw_clip(
 
   Fl_Scroll* s = (Fl_Scroll*)v;
 
-  Fl_Widget* const* a = s->array();
-
-  for (int i = s->children() - 2; i--;)
-  {
-    Fl_Widget& o = **a++;
-    s->draw_child(o);
-    s->draw_outside_label(o);
-  }
+  s->draw_clipped(s->children() - 2, false);
 
   Fl::clip_pop();
 
@@ -296,7 +289,7 @@ Fl_Scroll::draw()
 
   if (d & FL_DAMAGE_ALL)
   {
-    draw_clip(this, X, Y, W, H, skin_.normal_fcolor, skin_.normal_bcolor);
+    draw_clip(this, X, Y, W, H, skin_->normal_fcolor, skin_->normal_bcolor);
   }
 
   else
@@ -304,7 +297,7 @@ Fl_Scroll::draw()
     if (d & FL_DAMAGE_SCROLL)
     {
       fl_scroll(X, Y, W, H, oldx - xposition_, oldy - yposition_, draw_clip, this,
-                skin_);
+                *skin_);
 
       Fl_Widget* const* a = array();
       int L, R, T, B;
@@ -324,25 +317,23 @@ Fl_Scroll::draw()
         if ((int)((*a)->y() + (*a)->h()) > B) B = (*a)->y() + (*a)->h();
       }
 
-      if (L > X) draw_clip(this, X, Y, L - X, H, skin_.normal_fcolor,
-                             skin_.normal_bcolor);
+      if (L > X) draw_clip(this, X, Y, L - X, H, skin_->normal_fcolor,
+                             skin_->normal_bcolor);
 
-      if (R < (X + W)) draw_clip(this, R, Y, X + W - R, H, skin_.normal_fcolor,
-                                   skin_.normal_bcolor);
+      if (R < (X + W)) draw_clip(this, R, Y, X + W - R, H, skin_->normal_fcolor,
+                                   skin_->normal_bcolor);
 
-      if (T > Y) draw_clip(this, X, Y, W, T - Y, skin_.normal_fcolor,
-                             skin_.normal_bcolor);
+      if (T > Y) draw_clip(this, X, Y, W, T - Y, skin_->normal_fcolor,
+                             skin_->normal_bcolor);
 
-      if (B < (Y + H)) draw_clip(this, X, B, W, Y + H - B, skin_.normal_fcolor,
-                                   skin_.normal_bcolor);
+      if (B < (Y + H)) draw_clip(this, X, B, W, Y + H - B, skin_->normal_fcolor,
+                                   skin_->normal_bcolor);
     }
 
     if (d & FL_DAMAGE_CHILD)
     {
       Fl::clip_push(X, Y, W, H);
-      Fl_Widget* const* a = array();
-
-      for (int i = children() - 2; i--;) update_child(**a++);
+      draw_clipped(children() - 2, true);
 
       Fl::clip_pop();
     }
@@ -362,7 +353,7 @@ Fl_Scroll::draw()
     {
       scrollbar.clear_visible();
       draw_clip(this, si.vscroll.x, si.vscroll.y, si.vscroll.w, si.vscroll.h,
-                skin_.normal_fcolor, skin_.normal_bcolor);
+                skin_->normal_fcolor, skin_->normal_bcolor);
       d = FL_DAMAGE_ALL;
     }
 
@@ -376,7 +367,7 @@ Fl_Scroll::draw()
     {
       hscrollbar.clear_visible();
       draw_clip(this, si.hscroll.x, si.hscroll.y, si.hscroll.w, si.hscroll.h,
-                skin_.normal_fcolor, skin_.normal_bcolor);
+                skin_->normal_fcolor, skin_->normal_bcolor);
       d = FL_DAMAGE_ALL;
     }
 
@@ -409,8 +400,8 @@ Fl_Scroll::draw()
         hscrollbar.y(),
         0x20,
         1,
-        skin_.normal_fcolor,
-        skin_.normal_bcolor);
+        skin_->normal_fcolor,
+        skin_->normal_bcolor);
     }
 
 #endif
@@ -302,6 +302,19 @@ Fl_Widget::test_shortcut()
   return test_shortcut(label());
 }
 
+void
+Fl_Widget::update_label_shortcut()
+{
+  Fl::remove_shortcut(this, Fl::BIND_LABEL);
+
+  if (flags() & SHORTCUT_LABEL)
+  {
+    unsigned int key = label_shortcut(label());
+
+    if (key) Fl::add_shortcut(this, key, Fl::BIND_LABEL);
+  }
+}
+
 const char*
 Fl_System_Driver::shortcut_add_key_name(unsigned key, char* p, char* buf,
                                         const char** eom)
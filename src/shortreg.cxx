@@ -0,0 +1,401 @@
+/*
+ shortreg.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <stdlib.h>
+#include "fl.h"
+#include "fl_utf8.h"
+#include "menu_.h"
+#include "win.h"
+
+/*
+  Bindings are filed twice: by key, so a keystroke finds its owners
+  without touching unrelated widgets, and by owner, so a widget can drop
+  its bindings when its shortcut, label or menu changes or it is
+  destroyed.  Keys are folded to lower case and stripped of modifiers;
+  the owner still runs its own test when the event is delivered.
+*/
+struct binding
+{
+  Fl_Widget* owner;
+  unsigned int key;
+  int source;
+  binding* key_prev;
+  binding* key_next;
+  binding* owner_next;
+};
+
+enum
+{
+  BUCKETS = 256
+};
+
+static binding* by_key[BUCKETS];
+static binding* by_owner[BUCKETS];
+static binding* freelist;
+static unsigned int wildcards;
+
+/* menus whose items changed since they were last bound */
+static Fl_Menu_** stale;
+static int stale_count;
+static int stale_alloc;
+
+static unsigned int
+key_hash(
+  unsigned int const i_key)
+{
+  return (i_key ^ (i_key >> 8)) & (BUCKETS - 1);
+}
+
+static unsigned int
+owner_hash(
+  Fl_Widget const* i_owner)
+{
+  size_t l_ptr = (size_t)i_owner;
+
+  return (unsigned int)((l_ptr >> 4) ^ (l_ptr >> 12)) & (BUCKETS - 1);
+}
+
+static unsigned int
+normalize(
+  unsigned int const i_key)
+{
+  return (unsigned int)fl_tolower(i_key & FL_KEY_MASK);
+}
+
+void
+Fl::add_shortcut(
+  Fl_Widget* i_owner,
+  unsigned int const i_key,
+  int const i_source)
+{
+  unsigned int l_key = normalize(i_key);
+  binding** l_head = &by_key[key_hash(l_key)];
+  binding* l_bind;
+  unsigned int l_slot;
+
+  for (l_bind = *l_head; l_bind; l_bind = l_bind->key_next)
+  {
+    if (l_bind->owner == i_owner && l_bind->key == l_key &&
+        l_bind->source == i_source)
+    {
+      return;
+    }
+  }
+
+  l_bind = freelist;
+
+  if (l_bind) freelist = l_bind->key_next;
+
+  else l_bind = new binding;
+
+  l_bind->owner = i_owner;
+  l_bind->key = l_key;
+  l_bind->source = i_source;
+
+  l_bind->key_prev = 0;
+  l_bind->key_next = *l_head;
+
+  if (*l_head) (*l_head)->key_prev = l_bind;
+
+  *l_head = l_bind;
+
+  l_slot = owner_hash(i_owner);
+  l_bind->owner_next = by_owner[l_slot];
+  by_owner[l_slot] = l_bind;
+
+  if (0 == l_key) wildcards++;
+
+  return;
+}
+
+void
+Fl::remove_shortcut(
+  Fl_Widget* i_owner,
+  int const i_sources)
+{
+  binding** l_link = &by_owner[owner_hash(i_owner)];
+  int l_index;
+
+  while (*l_link)
+  {
+    binding* l_bind = *l_link;
+
+    if (l_bind->owner != i_owner || 0 == (l_bind->source & i_sources))
+    {
+      l_link = &l_bind->owner_next;
+      continue;
+    }
+
+    *l_link = l_bind->owner_next;
+
+    if (l_bind->key_prev) l_bind->key_prev->key_next = l_bind->key_next;
+
+    else by_key[key_hash(l_bind->key)] = l_bind->key_next;
+
+    if (l_bind->key_next) l_bind->key_next->key_prev = l_bind->key_prev;
+
+    if (0 == l_bind->key) wildcards--;
+
+    l_bind->key_next = freelist;
+    freelist = l_bind;
+  }
+
+  if (i_sources & BIND_MENU)
+  {
+    for (l_index = 0; stale_count > l_index; l_index++)
+    {
+      if (static_cast<Fl_Widget*>(stale[l_index]) == i_owner)
+      {
+        stale[l_index] = stale[--stale_count];
+        break;
+      }
+    }
+  }
+
+  return;
+}
+
+void
+Fl::menu_shortcuts_changed(
+  Fl_Menu_* i_menu)
+{
+  int l_index;
+
+  for (l_index = 0; stale_count > l_index; l_index++)
+  {
+    if (stale[l_index] == i_menu) return;
+  }
+
+  if (stale_count == stale_alloc)
+  {
+    int l_alloc = stale_alloc ? 2 * stale_alloc : 16;
+    void* l_ptr = realloc(stale, l_alloc * sizeof(Fl_Menu_*));
+
+    if (0 == l_ptr) return;
+
+    stale = (Fl_Menu_**)l_ptr;
+    stale_alloc = l_alloc;
+  }
+
+  stale[stale_count++] = i_menu;
+
+  return;
+}
+
+static Fl_Menu_Item const*
+bind_items(
+  Fl_Menu_* i_menu,
+  Fl_Menu_Item const* i_item,
+  bool const i_top)
+{
+  Fl_Menu_Item const* l_item = i_item;
+
+  for (; l_item->text; l_item++)
+  {
+    if (l_item->shortcut_)
+    {
+      Fl::add_shortcut(i_menu, l_item->shortcut_, Fl::BIND_MENU);
+    }
+
+    if (i_top)
+    {
+      unsigned int l_key = Fl_Widget::label_shortcut(l_item->text);
+
+      if (l_key) Fl::add_shortcut(i_menu, l_key, Fl::BIND_MENU);
+    }
+
+    if (l_item->flags & FL_SUBMENU)
+    {
+      l_item = bind_items(i_menu, l_item + 1, false);
+    }
+
+    else if ((l_item->flags & FL_SUBMENU_POINTER) && l_item->user_data_)
+    {
+      bind_items(i_menu, (Fl_Menu_Item const*)l_item->user_data_, false);
+    }
+  }
+
+  return l_item;
+}
+
+static void
+bind_stale_menus()
+{
+  while (stale_count)
+  {
+    Fl_Menu_* l_menu = stale[--stale_count];
+
+    Fl::remove_shortcut(l_menu, Fl::BIND_MENU);
+
+    if (l_menu->menu())
+    {
+      bind_items(l_menu, l_menu->menu(), true);
+    }
+  }
+
+  return;
+}
+
+/*
+  Keys a widget may consume as FL_SHORTCUT without binding them: scrollbar
+  and spinner stepping, Fl_Return_Button and Fl_Group navigation on Enter.
+*/
+static bool
+navigation_key(
+  int const i_key)
+{
+  bool l_nav = false;
+
+  switch (i_key)
+  {
+    case FL_Enter:
+    case FL_KP_Enter:
+    case FL_Left:
+    case FL_Up:
+    case FL_Right:
+    case FL_Down:
+    case FL_Page_Up:
+    case FL_Page_Down:
+    case FL_Home:
+    case FL_End:
+      l_nav = true;
+      break;
+
+    default:
+      break;
+  }
+
+  return l_nav;
+}
+
+bool
+Fl::walk_shortcut()
+{
+  return (wildcards || navigation_key(Fl::event_key()));
+}
+
+static void
+add_key(
+  unsigned int* io_key,
+  int* io_count,
+  unsigned int const i_key)
+{
+  unsigned int l_key = normalize(i_key);
+  int l_index;
+
+  if (0 == l_key) return;
+
+  for (l_index = 0; *io_count > l_index; l_index++)
+  {
+    if (io_key[l_index] == l_key) return;
+  }
+
+  io_key[(*io_count)++] = l_key;
+
+  return;
+}
+
+static bool
+reachable(
+  Fl_Widget* i_owner,
+  Fl_Window const* i_window)
+{
+  Fl_Window* l_top;
+
+  if (false == i_owner->takesevents() || 0 == i_owner->visible_r() ||
+      0 == i_owner->active_r())
+  {
+    return false;
+  }
+
+  l_top = i_owner->top_window();
+
+  if (Fl::modal()) return (l_top == Fl::modal());
+
+  return (l_top && (l_top == i_window || l_top == Fl::first_window()));
+}
+
+/*
+  Collects the widgets bound to the current key event, those under the
+  mouse first, as Fl_Group would have offered them.  The array is
+  allocated with malloc() and belongs to the caller.
+*/
+int
+Fl::find_shortcuts(
+  Fl_Window const* i_window,
+  Fl_Widget*** o_owner)
+{
+  unsigned int l_key[3];
+  int l_keys = 0;
+  int l_count = 0;
+  int l_alloc = 0;
+  Fl_Widget** l_owner = 0;
+  unsigned int l_char = 0;
+  int l_pass;
+  int l_index;
+  int l_seen;
+  binding* l_bind;
+
+  bind_stale_menus();
+
+  add_key(l_key, &l_keys, (unsigned int)Fl::event_key());
+
+  if (Fl::event_length())
+  {
+    l_char = fl_utf8decode((char const*)Fl::event_text(),
+                           (char const*)(Fl::event_text() + Fl::event_length()), 0);
+    add_key(l_key, &l_keys, l_char);
+  }
+
+  if (l_char && 0x20 > l_char && Fl::event_state(FL_CTRL))
+  {
+    add_key(l_key, &l_keys, l_char ^ 0x40);
+  }
+
+  for (l_pass = 0; 2 > l_pass; l_pass++)
+  {
+    for (l_index = 0; l_keys > l_index; l_index++)
+    {
+      l_bind = by_key[key_hash(l_key[l_index])];
+
+      for (; l_bind; l_bind = l_bind->key_next)
+      {
+        if (l_bind->key != l_key[l_index]) continue;
+
+        if ((0 == l_pass) != (0 != Fl::event_inside(l_bind->owner))) continue;
+
+        if (false == reachable(l_bind->owner, i_window)) continue;
+
+        for (l_seen = 0; l_count > l_seen; l_seen++)
+        {
+          if (l_owner[l_seen] == l_bind->owner) break;
+        }
+
+        if (l_count > l_seen) continue;
+
+        if (l_count == l_alloc)
+        {
+          int l_grow = l_alloc ? 2 * l_alloc : 16;
+          void* l_ptr = realloc(l_owner, l_grow * sizeof(Fl_Widget*));
+
+          if (0 == l_ptr) break;
+
+          l_owner = (Fl_Widget**)l_ptr;
+          l_alloc = l_grow;
+        }
+
+        l_owner[l_count++] = l_bind->owner;
+      }
+    }
+  }
+
+  (*o_owner) = l_owner;
+
+  return l_count;
+}
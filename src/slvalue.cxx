@@ -107,7 +107,7 @@ Fl_Value_Slider::draw()
   unsigned char buf[128];
   format(buf);
   fl_draw(buf, bxx, byy, bww, bhh, Fl_Label::FL_ALIGN_CLIP,
-          skin_.normal_fcolor, skin_.normal_bcolor, skin_.normal_fcolor);
+          skin_->normal_fcolor, skin_->normal_bcolor, skin_->normal_fcolor);
 
   return;
 }
@@ -0,0 +1,960 @@
+/*
+ table.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <limits.h>
+#include <stdlib.h>
+#include "table.h"
+#include "fl.h"
+#include "fl_clip.h"
+#include "fl_draw.h"
+#include "fl_rend.h"
+
+Fl_Table::Fl_Table(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  unsigned char const* i_label) :
+  Fl_Group(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label),
+  rows_(0),
+  cols_(0),
+  colx_(0),
+  row_header_(false),
+  row_header_w_(DEFAULT_WIDTH),
+  col_header_(false),
+  top_(0),
+  old_top_(0),
+  left_(0),
+  old_left_(0),
+  ndirty_(0),
+  cb_row_(-1),
+  cb_col_(-1)
+{
+
+  colx_ = (long*)malloc(sizeof(long));
+
+  if (colx_)
+  {
+    colx_[0] = 0;
+  }
+
+  vscroll_ = new Fl_Scrollbar(0, 0, 1, 1);
+  vscroll_->callback((Fl_Callback*)v_scrollbar_cb, this);
+
+  hscroll_ = new Fl_Scrollbar(0, 0, 1, 1);
+  hscroll_->callback((Fl_Callback*)h_scrollbar_cb, this);
+  hscroll_->type(FL_HORIZONTAL);
+
+  end();
+
+  resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  return;
+}
+
+Fl_Table::~Fl_Table()
+{
+  free(colx_);
+}
+
+void
+Fl_Table::rows(
+  long const i_rows)
+{
+
+  rows_ = (0 > i_rows) ? 0 : i_rows;
+
+  if (top_ > max_top())
+  {
+    top_ = max_top();
+  }
+
+  old_top_ = top_;
+
+  redraw();
+
+  return;
+}
+
+// New columns get DEFAULT_WIDTH.
+void
+Fl_Table::cols(
+  int const i_cols)
+{
+  int const count = (0 > i_cols) ? 0 : i_cols;
+  int col;
+
+  if (count > cols_)
+  {
+    long* colx = (long*)realloc(colx_, (count + 1) * sizeof(long));
+
+    if (0 == colx)
+    {
+      return;
+    }
+
+    colx_ = colx;
+
+    for (col = cols_; count > col; col++)
+    {
+      colx_[col + 1] = colx_[col] + DEFAULT_WIDTH;
+    }
+  }
+
+  cols_ = count;
+
+  if (left_ > max_left())
+  {
+    left_ = max_left();
+  }
+
+  old_left_ = left_;
+
+  redraw();
+
+  return;
+}
+
+unsigned int
+Fl_Table::col_width(
+  int const i_col) const
+{
+
+  if (0 > i_col)
+  {
+    return row_header_w_;
+  }
+
+  if (i_col >= cols_)
+  {
+    return 0;
+  }
+
+  return (unsigned int)(colx_[i_col + 1] - colx_[i_col]);
+}
+
+// Columns to the right shift by the change in width.
+void
+Fl_Table::col_width(
+  int const i_col,
+  unsigned int const i_width)
+{
+  long delta;
+  int col;
+
+  if (0 > i_col || i_col >= cols_)
+  {
+    return;
+  }
+
+  delta = (long)i_width - (colx_[i_col + 1] - colx_[i_col]);
+
+  if (0 == delta)
+  {
+    return;
+  }
+
+  for (col = i_col + 1; cols_ >= col; col++)
+  {
+    colx_[col] += delta;
+  }
+
+  if (left_ > max_left())
+  {
+    left_ = max_left();
+  }
+
+  old_left_ = left_;
+
+  redraw();
+
+  return;
+}
+
+void
+Fl_Table::col_width_all(
+  unsigned int const i_width)
+{
+  int col;
+
+  for (col = 0; cols_ > col; col++)
+  {
+    colx_[col + 1] = colx_[col] + (long)i_width;
+  }
+
+  if (left_ > max_left())
+  {
+    left_ = max_left();
+  }
+
+  old_left_ = left_;
+
+  redraw();
+
+  return;
+}
+
+void
+Fl_Table::row_header(
+  bool const i_on)
+{
+  row_header_ = i_on;
+  layout();
+  redraw();
+}
+
+void
+Fl_Table::row_header_width(
+  unsigned int const i_width)
+{
+  row_header_w_ = i_width;
+  layout();
+  redraw();
+}
+
+void
+Fl_Table::col_header(
+  bool const i_on)
+{
+  col_header_ = i_on;
+  layout();
+  redraw();
+}
+
+// Returns the column covering i_offset characters from the left edge
+// of column 0, -1 left of it and cols() right of the last column.
+int
+Fl_Table::x_to_col(
+  long const i_offset) const
+{
+  int lo = 0;
+  int hi = cols_;
+
+  if (0 > i_offset)
+  {
+    return -1;
+  }
+
+  while (lo < hi)
+  {
+    int const mid = (lo + hi) / 2;
+
+    if (colx_[mid + 1] <= i_offset)
+    {
+      lo = mid + 1;
+    }
+
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+long
+Fl_Table::max_top() const
+{
+  long top = rows_ - (long)data_area.h;
+
+  if (0 > top)
+  {
+    top = 0;
+  }
+
+  return top;
+}
+
+long
+Fl_Table::max_left() const
+{
+  long left = colx_[cols_] - (long)data_area.w;
+
+  if (0 > left)
+  {
+    left = 0;
+  }
+
+  return left;
+}
+
+void
+Fl_Table::scroll_to(
+  long const i_row,
+  long const i_left)
+{
+  long row = i_row;
+  long left = i_left;
+
+  if (row > max_top())
+  {
+    row = max_top();
+  }
+
+  if (0 > row)
+  {
+    row = 0;
+  }
+
+  if (left > max_left())
+  {
+    left = max_left();
+  }
+
+  if (0 > left)
+  {
+    left = 0;
+  }
+
+  if (row != top_ || left != left_)
+  {
+    top_ = row;
+    left_ = left;
+    damage(FL_DAMAGE_SCROLL);
+  }
+
+  return;
+}
+
+void
+Fl_Table::top_row(
+  long const i_row)
+{
+  scroll_to(i_row, left_);
+}
+
+void
+Fl_Table::left_col(
+  int const i_col)
+{
+  int col = i_col;
+
+  if (col >= cols_)
+  {
+    col = cols_ - 1;
+  }
+
+  if (0 > col)
+  {
+    col = 0;
+  }
+
+  scroll_to(top_, colx_[col]);
+
+  return;
+}
+
+bool
+Fl_Table::cell_visible(
+  long const i_row,
+  int const i_col) const
+{
+
+  if (i_row >= rows_ || i_col >= cols_)
+  {
+    return false;
+  }
+
+  if (0 <= i_row && (i_row < top_ || i_row >= top_ + (long)data_area.h))
+  {
+    return false;
+  }
+
+  if (0 <= i_col && (colx_[i_col + 1] <= left_ ||
+                     colx_[i_col] >= left_ + (long)data_area.w))
+  {
+    return false;
+  }
+
+  if ((0 > i_row && false == col_header_) ||
+      (0 > i_col && false == row_header_))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+// Cells off screen are dropped and a cell already pending is queued
+// once; past DIRTY_MAX pending cells the whole table is redrawn instead.
+void
+Fl_Table::redraw_cell(
+  long const i_row,
+  int const i_col)
+{
+  int index;
+
+  if (false == cell_visible(i_row, i_col))
+  {
+    return;
+  }
+
+  for (index = 0; ndirty_ > index; index++)
+  {
+    if (dirty_[index].row == i_row && dirty_[index].col == i_col)
+    {
+      return;
+    }
+  }
+
+  if (DIRTY_MAX <= ndirty_)
+  {
+    damage(FL_DAMAGE_EXPOSE);
+    return;
+  }
+
+  dirty_[ndirty_].row = i_row;
+  dirty_[ndirty_].col = i_col;
+  ndirty_++;
+
+  damage(FL_DAMAGE_USER1);
+
+  return;
+}
+
+void
+Fl_Table::redraw_range(
+  long const i_top,
+  long const i_bottom,
+  int const i_left,
+  int const i_right)
+{
+  long const top = (top_ > i_top) ? top_ : i_top;
+  long bottom = top_ + (long)data_area.h - 1;
+  int const left = (x_to_col(left_) > i_left) ? x_to_col(left_) : i_left;
+  int right = x_to_col(left_ + (long)data_area.w - 1);
+  long row;
+  int col;
+
+  if (i_bottom < bottom)
+  {
+    bottom = i_bottom;
+  }
+
+  if (i_right < right)
+  {
+    right = i_right;
+  }
+
+  for (row = top; bottom >= row; row++)
+  {
+    for (col = left; right >= col; col++)
+    {
+      redraw_cell(row, col);
+    }
+  }
+
+  return;
+}
+
+bool
+Fl_Table::find_cell(
+  int const i_pos_x,
+  int const i_pos_y,
+  long* o_row,
+  int* o_col) const
+{
+  long row = -1;
+  int col = -1;
+
+  if (i_pos_y >= data_area.y)
+  {
+    row = top_ + (long)(i_pos_y - data_area.y);
+  }
+
+  else if (false == col_header_ || i_pos_y < y())
+  {
+    return false;
+  }
+
+  if (i_pos_x >= data_area.x)
+  {
+    col = x_to_col(left_ + (long)(i_pos_x - data_area.x));
+  }
+
+  else if (false == row_header_ || i_pos_x < x())
+  {
+    return false;
+  }
+
+  if (row >= rows_ || row >= top_ + (long)data_area.h || col >= cols_ ||
+      i_pos_x >= data_area.x + (int)data_area.w)
+  {
+    return false;
+  }
+
+  *o_row = row;
+  *o_col = col;
+
+  return true;
+}
+
+void
+Fl_Table::layout()
+{
+  unsigned int const len_x = (w() > 1) ? w() - 1 : 0;
+  unsigned int const len_y = (h() > 1) ? h() - 1 : 0;
+  unsigned int header_x = row_header_ ? row_header_w_ : 0;
+  unsigned int header_y = col_header_ ? 1 : 0;
+
+  if (header_x > len_x)
+  {
+    header_x = len_x;
+  }
+
+  if (header_y > len_y)
+  {
+    header_y = len_y;
+  }
+
+  data_area.x = x() + (int)header_x;
+  data_area.y = y() + (int)header_y;
+  data_area.w = len_x - header_x;
+  data_area.h = len_y - header_y;
+
+  vscroll_->resize(x() + (int)len_x, y(), 1, len_y);
+  hscroll_->resize(x(), y() + (int)len_y, len_x, 1);
+
+  if (top_ > max_top())
+  {
+    top_ = max_top();
+  }
+
+  if (left_ > max_left())
+  {
+    left_ = max_left();
+  }
+
+  old_top_ = top_;
+  old_left_ = left_;
+
+  return;
+}
+
+void
+Fl_Table::resize(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y)
+{
+  Fl_Widget::resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+  layout();
+}
+
+void
+Fl_Table::update_scrollbars()
+{
+  long total = rows_;
+  long top = top_;
+  long width = colx_[cols_];
+  long left = left_;
+
+  if (INT_MAX < total)
+  {
+    total = INT_MAX;
+  }
+
+  if (INT_MAX < top)
+  {
+    top = INT_MAX;
+  }
+
+  if (INT_MAX < width)
+  {
+    width = INT_MAX;
+  }
+
+  if (INT_MAX < left)
+  {
+    left = INT_MAX;
+  }
+
+  vscroll_->value((int)top, (int)data_area.h, 0, (int)total);
+  vscroll_->linesize(1);
+  hscroll_->value((int)left, (int)data_area.w, 0, (int)width);
+  hscroll_->linesize(1);
+
+  return;
+}
+
+void
+Fl_Table::v_scrollbar_cb(
+  Fl_Scrollbar* i_bar,
+  Fl_Table* i_table)
+{
+  i_table->scroll_to(i_bar->value(), i_table->left_);
+}
+
+void
+Fl_Table::h_scrollbar_cb(
+  Fl_Scrollbar* i_bar,
+  Fl_Table* i_table)
+{
+  i_table->scroll_to(i_table->top_, i_bar->value());
+}
+
+void
+Fl_Table::draw_cell(
+  long const i_row,
+  int const i_col,
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y)
+{
+  Fl::draw_fill(i_pos_x, i_pos_y, i_len_x, i_len_y, 0x20,
+                skin_->normal_fcolor, skin_->normal_bcolor);
+}
+
+// Clips to the header or data area the cell belongs to, so a cell
+// scrolled half out of view does not paint over the headers.
+void
+Fl_Table::draw_one(
+  long const i_row,
+  int const i_col)
+{
+  int pos_x = x();
+  int pos_y = y();
+  unsigned int len_x = (unsigned int)(data_area.x - x());
+  unsigned int len_y = (unsigned int)(data_area.y - y());
+  int cell_x = x();
+  int cell_y = y();
+
+  if (0 <= i_col)
+  {
+    pos_x = data_area.x;
+    len_x = data_area.w;
+    cell_x = data_area.x + (int)(colx_[i_col] - left_);
+  }
+
+  if (0 <= i_row)
+  {
+    pos_y = data_area.y;
+    len_y = data_area.h;
+    cell_y = data_area.y + (int)(i_row - top_);
+  }
+
+  Fl::clip_push(pos_x, pos_y, len_x, len_y);
+  draw_cell(i_row, i_col, cell_x, cell_y, col_width(i_col), 1);
+  Fl::clip_pop();
+
+  return;
+}
+
+// Draws the cells and headers that meet the given rectangle, and blanks
+// the part of it beyond the last row or column.
+void
+Fl_Table::draw_area(
+  void* i_data,
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  enum Fl::foreground const i_fcolor,
+  enum Fl::background const i_bcolor)
+{
+  Fl_Table* table = (Fl_Table*)i_data;
+  int const data_x = table->data_area.x;
+  int const data_y = table->data_area.y;
+  int const right_x = i_pos_x + (int)i_len_x;
+  int const bottom_y = i_pos_y + (int)i_len_y;
+  long first_row = table->top_;
+  long last_row = table->top_ + (long)table->data_area.h - 1;
+  int first_col = table->x_to_col(table->left_);
+  int last_col = table->x_to_col(table->left_ + (long)table->data_area.w - 1);
+  int end_x;
+  int end_y;
+  long row;
+  int col;
+
+  if (i_pos_y > data_y)
+  {
+    first_row += (long)(i_pos_y - data_y);
+  }
+
+  if (bottom_y - 1 < data_y + (int)table->data_area.h - 1)
+  {
+    last_row = table->top_ + (long)(bottom_y - 1 - data_y);
+  }
+
+  if (last_row >= table->rows_)
+  {
+    last_row = table->rows_ - 1;
+  }
+
+  if (i_pos_x > data_x)
+  {
+    first_col = table->x_to_col(table->left_ + (long)(i_pos_x - data_x));
+  }
+
+  if (right_x - 1 < data_x + (int)table->data_area.w - 1)
+  {
+    last_col = table->x_to_col(table->left_ + (long)(right_x - 1 - data_x));
+  }
+
+  if (last_col >= table->cols_)
+  {
+    last_col = table->cols_ - 1;
+  }
+
+  Fl::clip_push(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  if (i_pos_y < data_y)
+  {
+    if (i_pos_x < data_x)
+    {
+      table->draw_one(-1, -1);
+    }
+
+    for (col = first_col; last_col >= col; col++)
+    {
+      table->draw_one(-1, col);
+    }
+  }
+
+  for (row = first_row; last_row >= row; row++)
+  {
+    if (i_pos_x < data_x)
+    {
+      table->draw_one(row, -1);
+    }
+
+    for (col = first_col; last_col >= col; col++)
+    {
+      table->draw_one(row, col);
+    }
+  }
+
+  if (table->colx_[table->cols_] - table->left_ < (long)(right_x - data_x))
+  {
+    end_x = data_x + (int)(table->colx_[table->cols_] - table->left_);
+
+    Fl::draw_fill(end_x, i_pos_y, (unsigned int)(right_x - end_x), i_len_y,
+                  0x20, i_fcolor, i_bcolor);
+  }
+
+  if (table->rows_ - table->top_ < (long)(bottom_y - data_y))
+  {
+    end_y = data_y + (int)(table->rows_ - table->top_);
+
+    Fl::draw_fill(i_pos_x, end_y, i_len_x, (unsigned int)(bottom_y - end_y),
+                  0x20, i_fcolor, i_bcolor);
+  }
+
+  Fl::clip_pop();
+
+  return;
+}
+
+// A scroll along one axis moves the cells still on screen and draws
+// only those that came into view; the header that does not move along
+// that axis is excluded from the move. Other changes redraw the cells
+// passed to redraw_cell(). The damage is read first: moving a
+// scrollbar damages this group too.
+void
+Fl_Table::draw()
+{
+  unsigned char const d = damage();
+  unsigned int const len_x = (w() > 1) ? w() - 1 : 0;
+  unsigned int const len_y = (h() > 1) ? h() - 1 : 0;
+  long delta_y = old_top_ - top_;
+  long delta_x = old_left_ - left_;
+  int index;
+
+  Fl::clip_push(x(), y(), w(), h());
+
+  update_scrollbars();
+
+  if (d & (FL_DAMAGE_ALL | FL_DAMAGE_CHILD))
+  {
+    vscroll_->damage(FL_DAMAGE_ALL);
+    hscroll_->damage(FL_DAMAGE_ALL);
+  }
+
+  update_child(*vscroll_);
+  update_child(*hscroll_);
+
+  if (d & FL_DAMAGE_ALL)
+  {
+    Fl::draw_fill(x() + (int)len_x, y() + (int)len_y, 1, 1, 0x20,
+                  skin_->normal_fcolor, skin_->normal_bcolor);
+  }
+
+  if ((d & (FL_DAMAGE_ALL | FL_DAMAGE_EXPOSE)) ||
+      (delta_x && delta_y))
+  {
+    draw_area(this, x(), y(), len_x, len_y,
+              skin_->normal_fcolor, skin_->normal_bcolor);
+  }
+
+  else
+  {
+    if (delta_y)
+    {
+      // a jump of a screen or more redraws everything anyway
+      if (delta_y > (long)data_area.h)
+      {
+        delta_y = (long)data_area.h;
+      }
+
+      else if (-(long)data_area.h > delta_y)
+      {
+        delta_y = -(long)data_area.h;
+      }
+
+      fl_scroll(x(), data_area.y, len_x, data_area.h, 0, (int)delta_y,
+                draw_area, this, *skin_);
+    }
+
+    else if (delta_x)
+    {
+      if (delta_x > (long)data_area.w)
+      {
+        delta_x = (long)data_area.w;
+      }
+
+      else if (-(long)data_area.w > delta_x)
+      {
+        delta_x = -(long)data_area.w;
+      }
+
+      fl_scroll(data_area.x, y(), data_area.w, len_y, (int)delta_x, 0,
+                draw_area, this, *skin_);
+    }
+
+    for (index = 0; ndirty_ > index; index++)
+    {
+      if (cell_visible(dirty_[index].row, dirty_[index].col))
+      {
+        draw_one(dirty_[index].row, dirty_[index].col);
+      }
+    }
+  }
+
+  Fl::clip_pop();
+
+  old_top_ = top_;
+  old_left_ = left_;
+  ndirty_ = 0;
+
+  return;
+}
+
+bool
+Fl_Table::handle(
+  enum Fl_Event const event)
+{
+  long const page = (1 < data_area.h) ? (long)data_area.h - 1 : 1;
+  long row;
+  int col;
+
+  switch (event)
+  {
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+      return 1;
+
+    case FL_PUSH:
+      if (false == find_cell(Fl::event_x(), Fl::event_y(), &row, &col))
+      {
+        return Fl_Group::handle(event);
+      }
+
+      if (Fl::focus() != this)
+      {
+        Fl::focus(this);
+        handle(FL_FOCUS);
+      }
+
+      cb_row_ = row;
+      cb_col_ = col;
+      do_callback();
+
+      return 1;
+
+    case FL_MOUSEWHEEL:
+      if (Fl::event_dy()) return vscroll_->handle(event);
+
+      return hscroll_->handle(event);
+
+    case FL_KEYBOARD:
+      switch (Fl::event_key())
+      {
+        case FL_Up:
+          scroll_to(top_ - 1, left_);
+          return 1;
+
+        case FL_Down:
+          scroll_to(top_ + 1, left_);
+          return 1;
+
+        case FL_Page_Up:
+          scroll_to(top_ - page, left_);
+          return 1;
+
+        case FL_Page_Down:
+          scroll_to(top_ + page, left_);
+          return 1;
+
+        case FL_Home:
+          if (Fl::event_state() & FL_CTRL)
+          {
+            scroll_to(0, 0);
+          }
+
+          else
+          {
+            scroll_to(top_, 0);
+          }
+
+          return 1;
+
+        case FL_End:
+          if (Fl::event_state() & FL_CTRL)
+          {
+            scroll_to(LONG_MAX, left_);
+          }
+
+          else
+          {
+            scroll_to(top_, LONG_MAX);
+          }
+
+          return 1;
+
+        case FL_Left:
+          col = x_to_col(left_);
+
+          // a column cut off on the left is first shown whole
+          if (col < cols_ && colx_[col] == left_)
+          {
+            col--;
+          }
+
+          left_col(col);
+          return 1;
+
+        case FL_Right:
+          left_col(x_to_col(left_) + 1);
+          return 1;
+
+        default:
+          break;
+      }
+
+      break;
+
+    default:
+      break;
+  }
+
+  return Fl_Group::handle(event);
+}
@@ -124,7 +124,7 @@ Fl_Text_Display::Fl_Text_Display(
   unsigned int const H,
   const unsigned char* l) :
   Fl_Group(X, Y, W, H, l),
-  skin_(Fl::_skin_editor)
+  skin_(&Fl::_skin_editor)
 {
 
   mMargin.left = LEFT_MARGIN;
@@ -152,6 +152,10 @@ Fl_Text_Display::Fl_Text_Display(
     for (int i = 1; i < mNVisibleLines; i++) mLineStarts[i] = -1;
   }
   mLineStarts[0] = 0;
+  mLineWidths = 0;
+  mLineWidthsSize = 0;
+  mNLineWidths = 0;
+  mLineWidthsValid = 0;
   mTopLineNum = 1;
   mAbsTopLineNum = 1;
   mNeedAbsTopLineNum = 0;
@@ -197,6 +201,7 @@ Fl_Text_Display::Fl_Text_Display(
   linenumber_format_  = (unsigned char*)strdup("%d");
 
   set_flag(SHORTCUT_LABEL);
+  update_label_shortcut();
   clear_flag(NEEDS_KEYBOARD);
 
   end();
@@ -218,6 +223,8 @@ Fl_Text_Display::~Fl_Text_Display()
 
   if (mLineStarts) delete[] mLineStarts;
 
+  if (mLineWidths) free(mLineWidths);
+
   if (linenumber_format_)
   {
     free((void*)linenumber_format_);
@@ -297,6 +304,9 @@ Fl_Text_Display::buffer( Fl_Text_Buffer* buf )
 int
 Fl_Text_Display::longest_vline() const
 {
+  if (!mContinuousWrap && mLineWidthsValid && mNLineWidths)
+    return mLineWidths[1];
+
   int longest = 0;
 
   for (int i = 0; i < mNVisibleLines; i++)
@@ -305,6 +315,99 @@ Fl_Text_Display::longest_vline() const
   return longest;
 }
 
+// mLineWidths is a max segment tree over the display width of every
+// buffer line. Leaves live at [mLineWidthsSize, mLineWidthsSize + mNLineWidths)
+// and node 1 holds the widest line. It is only kept while wrapping is off;
+// wrapped lines are bounded by the wrap margin and measured as before.
+
+static void
+line_widths_fixup(int* tree, int size, int first, int last)
+{
+  int lo = (size + first) >> 1;
+  int hi = (size + last) >> 1;
+
+  for (; lo >= 1; lo >>= 1, hi >>= 1)
+  {
+    for (int k = lo; k <= hi; k++)
+      tree[k] = max(tree[2 * k], tree[2 * k + 1]);
+  }
+}
+
+void
+Fl_Text_Display::line_widths_rebuild()
+{
+  mLineWidthsValid = 0;
+  mNLineWidths = 0;
+
+  if (!mBuffer || mContinuousWrap) return;
+
+  int nLines = mBuffer->count_lines(0, mBuffer->length()) + 1;
+
+  if (nLines > mLineWidthsSize)
+  {
+    int size = mLineWidthsSize ? mLineWidthsSize : 64;
+
+    while (size < nLines) size <<= 1;
+
+    free(mLineWidths);
+    mLineWidths = (int*)malloc(2 * size * sizeof(int));
+    mLineWidthsSize = size;
+  }
+
+  memset(mLineWidths, 0, 2 * mLineWidthsSize * sizeof(int));
+
+  int* leaf = mLineWidths + mLineWidthsSize;
+  int pos = 0;
+
+  for (int i = 0; i < nLines; i++)
+  {
+    leaf[i] = measure_line(pos);
+    pos = mBuffer->next_char(mBuffer->line_end(pos));
+  }
+
+  mNLineWidths = nLines;
+  line_widths_fixup(mLineWidths, mLineWidthsSize, 0, mLineWidthsSize - 1);
+  mLineWidthsValid = 1;
+}
+
+void
+Fl_Text_Display::line_widths_update(int line, int nOldLines, int nNewLines,
+                                    int lineStartPos)
+{
+  int count = mNLineWidths - nOldLines + nNewLines;
+
+  if (line < 0 || nOldLines > mNLineWidths - line || count > mLineWidthsSize)
+  {
+    line_widths_rebuild();
+    return;
+  }
+
+  int* leaf = mLineWidths + mLineWidthsSize;
+  int last = line + nNewLines - 1;
+
+  if (nOldLines != nNewLines)
+  {
+    memmove(leaf + line + nNewLines, leaf + line + nOldLines,
+            (mNLineWidths - line - nOldLines) * sizeof(int));
+
+    if (count < mNLineWidths)
+      memset(leaf + count, 0, (mNLineWidths - count) * sizeof(int));
+
+    last = max(count, mNLineWidths) - 1;
+  }
+
+  int pos = lineStartPos;
+
+  for (int i = line; i < line + nNewLines; i++)
+  {
+    leaf[i] = measure_line(pos);
+    pos = mBuffer->next_char(mBuffer->line_end(pos));
+  }
+
+  mNLineWidths = count;
+  line_widths_fixup(mLineWidths, mLineWidthsSize, line, last);
+}
+
 void
 Fl_Text_Display::resize(int const X, int const Y, unsigned int const W, unsigned int const H)
 {
@@ -669,13 +772,10 @@ Fl_Text_Display::insert_position( int newPos )
 
   mCursorPreferredXPos = -1;
 
-  redisplay_range(buffer()->prev_char_clipped(mCursorPos),
-                  buffer()->next_char(mCursorPos));
-
   mCursorPos = newPos;
 
-  redisplay_range(buffer()->prev_char_clipped(mCursorPos),
-                  buffer()->next_char(mCursorPos));
+  /* the caret is the terminal cursor, no text needs to be repainted */
+  damage(Fl_Widget::FL_DAMAGE_USER1);
 }
 
 
@@ -686,12 +786,20 @@ Fl_Text_Display::show_cursor(int b)
 
   if (!buffer()) return;
 
-  redisplay_range(buffer()->prev_char_clipped(mCursorPos),
-                  buffer()->next_char(mCursorPos));
+  damage(Fl_Widget::FL_DAMAGE_USER1);
 
   return;
 }
 
+void
+Fl_Text_Display::shortcut(int s)
+{
+  shortcut_ = s;
+  Fl::remove_shortcut(this, Fl::BIND_KEY);
+
+  if (s) Fl::add_shortcut(this, s);
+}
+
 void
 Fl_Text_Display::cursor_style(int style)
 {
@@ -728,6 +836,8 @@ Fl_Text_Display::wrap_mode(int wrap, int wrapMargin)
       break;
   }
 
+  line_widths_rebuild();
+
   if (buffer())
   {
     mNBufferLines = count_lines(0, buffer()->length(), true);
@@ -1326,8 +1436,26 @@ Fl_Text_Display::buffer_modified_cb( int pos, int nInserted, int nDeleted,
   IS_UTF8_ALIGNED2(buf, oldFirstChar)
 
   if ( nInserted != 0 || nDeleted != 0 )
+  {
     textD->mCursorPreferredXPos = -1;
 
+    if (!textD->mLineWidthsValid)
+    {
+      textD->line_widths_rebuild();
+    }
+
+    else
+    {
+      int line = ( pos >= oldFirstChar ) ?
+                 textD->mTopLineNum - 1 + buf->count_lines( oldFirstChar, pos ) :
+                 buf->count_lines( 0, pos );
+
+      textD->line_widths_update( line, countlines( deletedText ) + 1,
+                                 buf->count_lines( pos, pos + nInserted ) + 1,
+                                 buf->line_start( pos ) );
+    }
+  }
+
   if (textD->mContinuousWrap)
   {
     textD->find_wrap_range(deletedText, pos, nInserted, nDeleted,
@@ -1760,7 +1888,7 @@ Fl_Text_Display::find_x(const unsigned char* s, int len, int style, int x) const
   while (i < len)
   {
     int cl = fl_utf8len1(s[i]);
-    int w = int( string_width(s, i + cl, style) );
+    int w = last_w + int( string_width(s + i, cl, style) );
 
     if (w > x)
     {
@@ -1829,17 +1957,17 @@ Fl_Text_Display::draw_string(int style,
   }
 
   // int fsize = 1;
-  enum Fl::foreground fcolor = Fl_Widget::skin_.normal_fcolor;
-  enum Fl::background bcolor = Fl_Widget::skin_.normal_bcolor;
+  enum Fl::foreground fcolor = Fl_Widget::skin_->normal_fcolor;
+  enum Fl::background bcolor = Fl_Widget::skin_->normal_bcolor;
 
   if (style & HIGHLIGHT_MASK)
   {
-    fcolor = Fl_Widget::skin_.highlight_fcolor;
+    fcolor = Fl_Widget::skin_->highlight_fcolor;
   }
 
   if ( !active_r() )
   {
-    fcolor = Fl_Widget::skin_.disabled_fcolor;
+    fcolor = Fl_Widget::skin_->disabled_fcolor;
   }
 
   if (!(style & TEXT_ONLY_MASK))
@@ -1863,12 +1991,12 @@ Fl_Text_Display::clear_rect(int style,
   if ( width == 0 )
     return;
 
-  enum Fl::foreground fcolor = Fl_Widget::skin_.normal_fcolor;
-  enum Fl::background bcolor = Fl_Widget::skin_.normal_bcolor;
+  enum Fl::foreground fcolor = Fl_Widget::skin_->normal_fcolor;
+  enum Fl::background bcolor = Fl_Widget::skin_->normal_bcolor;
 
   if (style & HIGHLIGHT_MASK)
   {
-    fcolor = Fl_Widget::skin_.highlight_fcolor;
+    fcolor = Fl_Widget::skin_->highlight_fcolor;
   }
 
   Fl::draw_fill(X, Y, width, height, 0x20, fcolor, bcolor);
@@ -1945,7 +2073,7 @@ Fl_Text_Display::string_width( const unsigned char* string, int length,
                                int style ) const
 {
   IS_UTF8_ALIGNED(string)
-  return length;
+  return fl_utf8width((const char*)string, length);
 }
 
 
@@ -2419,6 +2547,17 @@ countlines( const unsigned char* string )
 }
 
 
+int
+Fl_Text_Display::measure_line( int lineStartPos ) const
+{
+  int lineLen = buffer()->line_end( lineStartPos ) - lineStartPos;
+
+  if (lineLen <= 0) return 0;
+
+  return handle_vline(GET_WIDTH, lineStartPos, lineLen, 0, 0, 0, 0, 0, 0);
+}
+
+
 int
 Fl_Text_Display::measure_vline( int visLineNum ) const
 {
@@ -2940,15 +3079,15 @@ Fl_Text_Display::draw(void)
     return;
   }
 
-  // enum Fl::foreground fcolor = Fl_Widget::skin_.normal_fcolor;
-  // enum Fl::background bcolor = Fl_Widget::skin_.normal_bcolor;
+  // enum Fl::foreground fcolor = Fl_Widget::skin_->normal_fcolor;
+  // enum Fl::background bcolor = Fl_Widget::skin_->normal_bcolor;
 
   Fl::clip_push(x(), y(), w(), h());
 
 /*
   if ( !active_r() )
   {
-    fcolor = Fl_Widget::skin_.disabled_fcolor;
+    fcolor = Fl_Widget::skin_->disabled_fcolor;
   }
 */
 
@@ -2967,19 +3106,19 @@ Fl_Text_Display::draw(void)
 
     Fl::draw_fill(text_area.x - mMargin.left, text_area.y - mMargin.top,
                   mMargin.left, text_area.h + mMargin.top + mMargin.bottom,
-                  skin_.margin_fillc, skin_.margin_fcolor, skin_.margin_bcolor);
+                  skin_->margin_fillc, skin_->margin_fcolor, skin_->margin_bcolor);
 
     Fl::draw_fill(text_area.x + text_area.w, text_area.y - mMargin.top,
                   mMargin.right, text_area.h + mMargin.top + mMargin.bottom,
-                  skin_.margin_fillc, skin_.margin_fcolor, skin_.margin_bcolor);
+                  skin_->margin_fillc, skin_->margin_fcolor, skin_->margin_bcolor);
 
     Fl::draw_fill(text_area.x, text_area.y - mMargin.top,
                   text_area.w, mMargin.top,
-                  skin_.margin_fillc, skin_.margin_fcolor, skin_.margin_bcolor);
+                  skin_->margin_fillc, skin_->margin_fcolor, skin_->margin_bcolor);
 
     Fl::draw_fill(text_area.x, text_area.y + text_area.h,
                   text_area.w, mMargin.bottom,
-                  skin_.margin_fillc, skin_.margin_fcolor, skin_.margin_bcolor);
+                  skin_->margin_fillc, skin_->margin_fcolor, skin_->margin_bcolor);
 
 #if 0
 
@@ -3002,11 +3141,11 @@ Fl_Text_Display::draw(void)
 
     Fl::draw_fill(text_area.x - mMargin.left, mCursorOldY,
                   mMargin.left, 1,
-                  skin_.margin_fillc, skin_.margin_fcolor, skin_.margin_bcolor);
+                  skin_->margin_fillc, skin_->margin_fcolor, skin_->margin_bcolor);
 
     Fl::draw_fill(text_area.x + text_area.w, mCursorOldY,
                   mMargin.right, 1,
-                  skin_.margin_fillc, skin_.margin_fcolor, skin_.margin_bcolor);
+                  skin_->margin_fillc, skin_->margin_fcolor, skin_->margin_bcolor);
 
     Fl::clip_pop();
   }
@@ -3057,7 +3196,7 @@ Fl_Text_Display::draw(void)
   int has_selection = buffer()->selection_position(&start, &end);
 
   if (damage() & (Fl_Widget::FL_DAMAGE_ALL | Fl_Widget::FL_DAMAGE_SCROLL |
-                  Fl_Widget::FL_DAMAGE_EXPOSE)
+                  Fl_Widget::FL_DAMAGE_EXPOSE | Fl_Widget::FL_DAMAGE_USER1)
       && (
         (Fl::screen_driver()->has_marked_text() && Fl::compose_state) ||
         (!has_selection) || mCursorPos < start || mCursorPos > end) &&
@@ -3070,6 +3209,17 @@ Fl_Text_Display::draw(void)
       draw_cursor(X, Y);
       mCursorOldY = Y;
     }
+
+    else
+    {
+      Fl::caret_hide();
+    }
+  }
+
+  else if ((damage() & Fl_Widget::FL_DAMAGE_USER1) &&
+           Fl::focus() == (Fl_Widget*)this)
+  {
+    Fl::caret_hide();
   }
 
   draw_line_numbers(true);
@@ -0,0 +1,1051 @@
+/*
+ tree.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tree.h"
+#include "fl.h"
+#include "fl_clip.h"
+#include "fl_draw.h"
+#include "fl_rend.h"
+
+Fl_Tree::Fl_Tree(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  unsigned char const* i_label) :
+  Fl_Group(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label),
+  populate_cb_(0),
+  populate_data_(0),
+  nodes_(0),
+  nnodes_(0),
+  anodes_(0),
+  last_root_(-1),
+  text_(0),
+  ntext_(0),
+  atext_(0),
+  rows_(0),
+  nrows_(0),
+  arows_(0),
+  top_(0),
+  old_top_(0),
+  value_(-1),
+  dirty_first_(-1),
+  dirty_last_(-1),
+  row_(0),
+  row_len_(0)
+{
+
+  vscroll_ = new Fl_Scrollbar(0, 0, 1, 1);
+  vscroll_->callback((Fl_Callback*)scrollbar_cb, this);
+
+  end();
+
+  resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  return;
+}
+
+Fl_Tree::~Fl_Tree()
+{
+  free(nodes_);
+  free(text_);
+  free(rows_);
+  free(row_);
+}
+
+// Returns the new node, or -1 if i_parent is not a node or memory ran
+// out. A node shown open gets the new child as its last row.
+int
+Fl_Tree::add(
+  int const i_parent,
+  unsigned char const* i_label,
+  bool const i_branch)
+{
+  size_t const len = strlen((char const*)i_label) + 1;
+  int const id = nnodes_;
+  node* entry;
+  int row;
+
+  if (-1 > i_parent || i_parent >= nnodes_)
+  {
+    return -1;
+  }
+
+  if (nnodes_ == anodes_)
+  {
+    int const count = anodes_ ? 2 * anodes_ : 64;
+    node* block = (node*)realloc(nodes_, count * sizeof(node));
+
+    if (0 == block)
+    {
+      return -1;
+    }
+
+    nodes_ = block;
+    anodes_ = count;
+  }
+
+  if (ntext_ + len > atext_)
+  {
+    size_t size = atext_ ? 2 * atext_ : 1024;
+    unsigned char* block;
+
+    while (ntext_ + len > size)
+    {
+      size *= 2;
+    }
+
+    block = (unsigned char*)realloc(text_, size);
+
+    if (0 == block)
+    {
+      return -1;
+    }
+
+    text_ = block;
+    atext_ = size;
+  }
+
+  memcpy(text_ + ntext_, i_label, len);
+
+  entry = &nodes_[id];
+  entry->parent = i_parent;
+  entry->first = -1;
+  entry->last = -1;
+  entry->next = -1;
+  entry->depth = (0 > i_parent) ? 0 : nodes_[i_parent].depth + 1;
+  entry->label = ntext_;
+  entry->flags = i_branch ? NODE_BRANCH : 0;
+
+  ntext_ += len;
+  nnodes_++;
+
+  if (0 > i_parent)
+  {
+    if (0 <= last_root_)
+    {
+      nodes_[last_root_].next = id;
+    }
+
+    last_root_ = id;
+    row = nrows_;
+  }
+
+  else
+  {
+    node* const up = &nodes_[i_parent];
+
+    if (0 <= up->last)
+    {
+      nodes_[up->last].next = id;
+    }
+
+    else
+    {
+      up->first = id;
+    }
+
+    up->last = id;
+    up->flags |= NODE_BRANCH | NODE_POPULATED;
+
+    row = -1;
+
+    if ((up->flags & NODE_OPEN) && shown(i_parent))
+    {
+      row = find_row(i_parent);
+
+      if (0 <= row)
+      {
+        row = subtree_end(row);
+      }
+    }
+  }
+
+  if (0 <= row && insert_rows(row, 1))
+  {
+    rows_[row] = id;
+
+    if (value_ >= row)
+    {
+      value_++;
+    }
+
+    redraw_rows(row, nrows_ - 1);
+  }
+
+  return id;
+}
+
+void
+Fl_Tree::clear()
+{
+  nnodes_ = 0;
+  last_root_ = -1;
+  ntext_ = 0;
+  nrows_ = 0;
+  top_ = 0;
+  old_top_ = 0;
+  value_ = -1;
+  redraw();
+}
+
+unsigned char const*
+Fl_Tree::label(
+  int const i_node) const
+{
+  return (0 <= i_node && i_node < nnodes_) ?
+         text_ + nodes_[i_node].label : 0;
+}
+
+int
+Fl_Tree::parent(
+  int const i_node) const
+{
+  return (0 <= i_node && i_node < nnodes_) ? nodes_[i_node].parent : -1;
+}
+
+int
+Fl_Tree::depth(
+  int const i_node) const
+{
+  return (0 <= i_node && i_node < nnodes_) ? nodes_[i_node].depth : -1;
+}
+
+bool
+Fl_Tree::is_branch(
+  int const i_node) const
+{
+  return (0 <= i_node && i_node < nnodes_ &&
+          (nodes_[i_node].flags & NODE_BRANCH));
+}
+
+bool
+Fl_Tree::is_open(
+  int const i_node) const
+{
+  return (0 <= i_node && i_node < nnodes_ &&
+          (nodes_[i_node].flags & NODE_OPEN));
+}
+
+// A node has a row when every node above it is open.
+bool
+Fl_Tree::shown(
+  int const i_node) const
+{
+  int up = nodes_[i_node].parent;
+
+  for (; 0 <= up; up = nodes_[up].parent)
+  {
+    if (0 == (nodes_[up].flags & NODE_OPEN))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int
+Fl_Tree::find_row(
+  int const i_node) const
+{
+  int row;
+
+  for (row = 0; nrows_ > row; row++)
+  {
+    if (rows_[row] == i_node)
+    {
+      return row;
+    }
+  }
+
+  return -1;
+}
+
+// Returns the row after the last row below the node on i_row.
+int
+Fl_Tree::subtree_end(
+  int const i_row) const
+{
+  int const level = nodes_[rows_[i_row]].depth;
+  int row = i_row + 1;
+
+  while (row < nrows_ && nodes_[rows_[row]].depth > level)
+  {
+    row++;
+  }
+
+  return row;
+}
+
+// Walks the nodes below i_root in display order, entering open nodes
+// only.
+int
+Fl_Tree::next_shown(
+  int const i_node,
+  int const i_root) const
+{
+  int at = i_node;
+
+  if ((nodes_[at].flags & NODE_OPEN) && 0 <= nodes_[at].first)
+  {
+    return nodes_[at].first;
+  }
+
+  while (at != i_root)
+  {
+    if (0 <= nodes_[at].next)
+    {
+      return nodes_[at].next;
+    }
+
+    at = nodes_[at].parent;
+  }
+
+  return -1;
+}
+
+bool
+Fl_Tree::insert_rows(
+  int const i_row,
+  int const i_count)
+{
+
+  if (nrows_ + i_count > arows_)
+  {
+    int count = arows_ ? 2 * arows_ : 64;
+    int* block;
+
+    while (nrows_ + i_count > count)
+    {
+      count *= 2;
+    }
+
+    block = (int*)realloc(rows_, count * sizeof(int));
+
+    if (0 == block)
+    {
+      return false;
+    }
+
+    rows_ = block;
+    arows_ = count;
+  }
+
+  memmove(rows_ + i_row + i_count, rows_ + i_row,
+          (nrows_ - i_row) * sizeof(int));
+  nrows_ += i_count;
+
+  return true;
+}
+
+// Splices the rows of the newly shown nodes in after i_row; rows
+// further down move, so everything below is redrawn.
+void
+Fl_Tree::open_row(
+  int const i_row)
+{
+  int const id = rows_[i_row];
+  int count = 0;
+  int at;
+  int row;
+
+  if (0 == (nodes_[id].flags & NODE_BRANCH) ||
+      (nodes_[id].flags & NODE_OPEN))
+  {
+    return;
+  }
+
+  if (0 == (nodes_[id].flags & NODE_POPULATED))
+  {
+    nodes_[id].flags |= NODE_POPULATED;
+
+    if (populate_cb_)
+    {
+      (*populate_cb_)(this, id, populate_data_);
+    }
+  }
+
+  nodes_[id].flags |= NODE_OPEN;
+
+  for (at = next_shown(id, id); 0 <= at; at = next_shown(at, id))
+  {
+    count++;
+  }
+
+  if (false == insert_rows(i_row + 1, count))
+  {
+    nodes_[id].flags &= ~NODE_OPEN;
+    return;
+  }
+
+  row = i_row + 1;
+
+  for (at = next_shown(id, id); 0 <= at; at = next_shown(at, id))
+  {
+    rows_[row++] = at;
+  }
+
+  if (value_ > i_row)
+  {
+    value_ += count;
+  }
+
+  redraw_rows(i_row, nrows_ - 1);
+
+  return;
+}
+
+void
+Fl_Tree::close_row(
+  int const i_row)
+{
+  int const id = rows_[i_row];
+  int const end = subtree_end(i_row);
+  int const count = end - i_row - 1;
+
+  if (0 == (nodes_[id].flags & NODE_OPEN))
+  {
+    return;
+  }
+
+  nodes_[id].flags &= ~NODE_OPEN;
+
+  memmove(rows_ + i_row + 1, rows_ + end, (nrows_ - end) * sizeof(int));
+  nrows_ -= count;
+
+  if (value_ > i_row)
+  {
+    value_ = (value_ < end) ? i_row : value_ - count;
+  }
+
+  redraw_rows(i_row, top_ + (int)text_area.h - 1);
+
+  if (top_ > max_top())
+  {
+    scroll_to(max_top());
+  }
+
+  return;
+}
+
+void
+Fl_Tree::open(
+  int const i_node)
+{
+  int row;
+
+  if (0 > i_node || i_node >= nnodes_)
+  {
+    return;
+  }
+
+  row = shown(i_node) ? find_row(i_node) : -1;
+
+  if (0 <= row)
+  {
+    open_row(row);
+  }
+
+  else if (nodes_[i_node].flags & NODE_BRANCH)
+  {
+    if (0 == (nodes_[i_node].flags & NODE_POPULATED))
+    {
+      nodes_[i_node].flags |= NODE_POPULATED;
+
+      if (populate_cb_)
+      {
+        (*populate_cb_)(this, i_node, populate_data_);
+      }
+    }
+
+    nodes_[i_node].flags |= NODE_OPEN;
+  }
+
+  return;
+}
+
+void
+Fl_Tree::close(
+  int const i_node)
+{
+  int row;
+
+  if (0 > i_node || i_node >= nnodes_)
+  {
+    return;
+  }
+
+  row = shown(i_node) ? find_row(i_node) : -1;
+
+  if (0 <= row)
+  {
+    close_row(row);
+  }
+
+  else
+  {
+    nodes_[i_node].flags &= ~NODE_OPEN;
+  }
+
+  return;
+}
+
+// Opens the nodes above i_node as needed so it has a row.
+void
+Fl_Tree::value(
+  int const i_node)
+{
+  int const old = value_;
+  int up;
+  int row = -1;
+
+  if (0 <= i_node && i_node < nnodes_)
+  {
+    while (false == shown(i_node))
+    {
+      // open the highest closed node above i_node
+      int closed = -1;
+
+      for (up = nodes_[i_node].parent; 0 <= up; up = nodes_[up].parent)
+      {
+        if (0 == (nodes_[up].flags & NODE_OPEN))
+        {
+          closed = up;
+        }
+      }
+
+      open(closed);
+
+      if (false == is_open(closed))
+      {
+        break;
+      }
+    }
+
+    row = shown(i_node) ? find_row(i_node) : -1;
+  }
+
+  value_ = row;
+
+  redraw_rows(old, old);
+  redraw_rows(value_, value_);
+
+  if (0 <= value_)
+  {
+    show_row(value_);
+  }
+
+  return;
+}
+
+int
+Fl_Tree::max_top() const
+{
+  int top = nrows_ - (int)text_area.h;
+
+  if (0 > top)
+  {
+    top = 0;
+  }
+
+  return top;
+}
+
+void
+Fl_Tree::scroll_to(
+  int const i_row)
+{
+  int row = i_row;
+
+  if (row > max_top())
+  {
+    row = max_top();
+  }
+
+  if (0 > row)
+  {
+    row = 0;
+  }
+
+  if (row != top_)
+  {
+    top_ = row;
+    damage(FL_DAMAGE_SCROLL);
+  }
+
+  return;
+}
+
+void
+Fl_Tree::top_row(
+  int const i_row)
+{
+  scroll_to(i_row);
+}
+
+void
+Fl_Tree::show_row(
+  int const i_row)
+{
+
+  if (i_row < top_)
+  {
+    scroll_to(i_row);
+  }
+
+  else if (i_row >= top_ + (int)text_area.h)
+  {
+    scroll_to(i_row - (int)text_area.h + 1);
+  }
+
+  return;
+}
+
+void
+Fl_Tree::move_to(
+  int const i_row)
+{
+  int const old = value_;
+  int row = i_row;
+
+  if (0 == nrows_)
+  {
+    return;
+  }
+
+  if (0 > row)
+  {
+    row = 0;
+  }
+
+  if (row >= nrows_)
+  {
+    row = nrows_ - 1;
+  }
+
+  if (row == old)
+  {
+    return;
+  }
+
+  value_ = row;
+
+  redraw_rows(old, old);
+  redraw_rows(row, row);
+  show_row(row);
+
+  do_callback();
+
+  return;
+}
+
+// Marks rows for the next draw; rows off screen are dropped.
+void
+Fl_Tree::redraw_rows(
+  int const i_first,
+  int const i_last)
+{
+  int first = (top_ > i_first) ? top_ : i_first;
+  int last = top_ + (int)text_area.h - 1;
+
+  if (i_last < last)
+  {
+    last = i_last;
+  }
+
+  if (0 > first || first > last)
+  {
+    return;
+  }
+
+  if (0 > dirty_first_ || first < dirty_first_)
+  {
+    dirty_first_ = first;
+  }
+
+  if (last > dirty_last_)
+  {
+    dirty_last_ = last;
+  }
+
+  damage(FL_DAMAGE_USER1);
+
+  return;
+}
+
+void
+Fl_Tree::update_scrollbar()
+{
+  vscroll_->value(top_, (int)text_area.h, 0, nrows_);
+  vscroll_->linesize(1);
+}
+
+void
+Fl_Tree::scrollbar_cb(
+  Fl_Scrollbar* i_bar,
+  Fl_Tree* i_tree)
+{
+  i_tree->scroll_to(i_bar->value());
+}
+
+void
+Fl_Tree::resize(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y)
+{
+
+  Fl_Widget::resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  text_area.x = i_pos_x;
+  text_area.y = i_pos_y;
+  text_area.w = (i_len_x > 1) ? i_len_x - 1 : 0;
+  text_area.h = i_len_y;
+
+  vscroll_->resize(i_pos_x + text_area.w, i_pos_y, 1, text_area.h);
+
+  if (row_len_ < text_area.w)
+  {
+    unsigned char* row = (unsigned char*)realloc(row_, text_area.w);
+
+    if (row)
+    {
+      row_ = row;
+      row_len_ = text_area.w;
+    }
+  }
+
+  if (top_ > max_top())
+  {
+    top_ = max_top();
+  }
+
+  old_top_ = top_;
+
+  return;
+}
+
+// Draws the row indented by depth, with '+' before a closed branch and
+// '-' before an open one.
+void
+Fl_Tree::draw_row(
+  int const i_row)
+{
+  int const ypos = text_area.y + (i_row - top_);
+  unsigned int const cols = (row_len_ < text_area.w) ? row_len_ : text_area.w;
+  enum Fl::foreground fcolor = skin_->normal_fcolor;
+  enum Fl::background bcolor = skin_->normal_bcolor;
+  node const* entry;
+  unsigned char const* text;
+  unsigned int col;
+
+  if (i_row < top_ || i_row >= top_ + (int)text_area.h)
+  {
+    return;
+  }
+
+  if (i_row >= nrows_ || 0 == row_)
+  {
+    Fl::draw_fill(text_area.x, ypos, text_area.w, 1, 0x20, fcolor, bcolor);
+    return;
+  }
+
+  if (false == active_r())
+  {
+    fcolor = skin_->disabled_fcolor;
+  }
+
+  else if (i_row == value_)
+  {
+    if (Fl::focus() == this)
+    {
+      fcolor = skin_->focused_fcolor;
+      bcolor = skin_->focused_bcolor;
+    }
+
+    else
+    {
+      fcolor = skin_->highlight_fcolor;
+    }
+  }
+
+  entry = &nodes_[rows_[i_row]];
+  text = text_ + entry->label;
+
+  memset(row_, ' ', cols);
+
+  col = (unsigned int)(entry->depth * INDENT);
+
+  if (col < cols && (entry->flags & NODE_BRANCH))
+  {
+    row_[col] = (entry->flags & NODE_OPEN) ? '-' : '+';
+  }
+
+  for (col += 2; col < cols && *text; col++, text++)
+  {
+    row_[col] = (0x20 > *text || 0x7f == *text) ? '.' : *text;
+  }
+
+  Fl::draw_puts(text_area.x, ypos, row_, cols, fcolor, bcolor);
+
+  return;
+}
+
+void
+Fl_Tree::draw_area(
+  void* i_data,
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  enum Fl::foreground const i_fcolor,
+  enum Fl::background const i_bcolor)
+{
+  Fl_Tree* tree = (Fl_Tree*)i_data;
+  int row = tree->top_ + (i_pos_y - tree->text_area.y);
+  int const end = row + (int)i_len_y;
+
+  for (; end > row; row++)
+  {
+    tree->draw_row(row);
+  }
+
+  return;
+}
+
+// Scrolling moves the rows on screen and draws those that came into
+// view; other changes redraw the rows marked by redraw_rows. The damage
+// is read first: moving the scrollbar damages this group too.
+void
+Fl_Tree::draw()
+{
+  unsigned char const d = damage();
+  int row;
+
+  Fl::clip_push(x(), y(), w(), h());
+
+  update_scrollbar();
+
+  if (d & (FL_DAMAGE_ALL | FL_DAMAGE_CHILD))
+  {
+    vscroll_->damage(FL_DAMAGE_ALL);
+  }
+
+  update_child(*vscroll_);
+
+  Fl::clip_push(text_area.x, text_area.y, text_area.w, text_area.h);
+
+  if (d & (FL_DAMAGE_ALL | FL_DAMAGE_EXPOSE))
+  {
+    draw_area(this, text_area.x, text_area.y, text_area.w, text_area.h,
+              skin_->normal_fcolor, skin_->normal_bcolor);
+  }
+
+  else
+  {
+    if ((d & FL_DAMAGE_SCROLL) && old_top_ != top_)
+    {
+      int delta = old_top_ - top_;
+
+      if (delta > (int)text_area.h)
+      {
+        delta = (int)text_area.h;
+      }
+
+      else if (-(int)text_area.h > delta)
+      {
+        delta = -(int)text_area.h;
+      }
+
+      fl_scroll(text_area.x, text_area.y, text_area.w, text_area.h, 0, delta,
+                draw_area, this, *skin_);
+    }
+
+    if ((d & FL_DAMAGE_USER1) && 0 <= dirty_first_)
+    {
+      for (row = dirty_first_; dirty_last_ >= row; row++)
+      {
+        draw_row(row);
+      }
+    }
+  }
+
+  Fl::clip_pop();
+  Fl::clip_pop();
+
+  old_top_ = top_;
+  dirty_first_ = -1;
+  dirty_last_ = -1;
+
+  return;
+}
+
+bool
+Fl_Tree::handle(
+  enum Fl_Event const event)
+{
+  int const page = (1 < text_area.h) ? (int)text_area.h - 1 : 1;
+  int row;
+
+  switch (event)
+  {
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+      redraw_rows(value_, value_);
+      return 1;
+
+    case FL_PUSH:
+      if (false == Fl::event_inside(text_area.x, text_area.y, text_area.w,
+                                    text_area.h))
+      {
+        return Fl_Group::handle(event);
+      }
+
+      if (Fl::focus() != this)
+      {
+        Fl::focus(this);
+        handle(FL_FOCUS);
+      }
+
+      row = top_ + (Fl::event_y() - text_area.y);
+
+      if (row >= nrows_)
+      {
+        return 1;
+      }
+
+      // a click on the marker, or a double click, opens or closes
+      if (Fl::event_clicks() || Fl::event_x() == text_area.x +
+          nodes_[rows_[row]].depth * INDENT)
+      {
+        if (nodes_[rows_[row]].flags & NODE_OPEN)
+        {
+          close_row(row);
+        }
+
+        else
+        {
+          open_row(row);
+        }
+      }
+
+      move_to(row);
+
+      return 1;
+
+    case FL_MOUSEWHEEL:
+      return vscroll_->handle(event);
+
+    case FL_KEYBOARD:
+      switch (Fl::event_key())
+      {
+        case FL_Up:
+          move_to(value_ - 1);
+          return 1;
+
+        case FL_Down:
+          move_to(value_ + 1);
+          return 1;
+
+        case FL_Page_Up:
+          move_to(value_ - page);
+          return 1;
+
+        case FL_Page_Down:
+          move_to(value_ + page);
+          return 1;
+
+        case FL_Home:
+          move_to(0);
+          return 1;
+
+        case FL_End:
+          move_to(INT_MAX);
+          return 1;
+
+        case FL_Right:
+          if (0 > value_)
+          {
+            move_to(0);
+          }
+
+          else if (0 == (nodes_[rows_[value_]].flags & NODE_OPEN))
+          {
+            open_row(value_);
+          }
+
+          else if (value_ + 1 < subtree_end(value_))
+          {
+            move_to(value_ + 1);
+          }
+
+          return 1;
+
+        case FL_Left:
+          if (0 > value_)
+          {
+            move_to(0);
+          }
+
+          else if (nodes_[rows_[value_]].flags & NODE_OPEN)
+          {
+            close_row(value_);
+          }
+
+          else
+          {
+            int const up = nodes_[rows_[value_]].parent;
+
+            for (row = value_ - 1; 0 <= row && 0 <= up; row--)
+            {
+              if (rows_[row] == up)
+              {
+                move_to(row);
+                break;
+              }
+            }
+          }
+
+          return 1;
+
+        case FL_Enter:
+        case FL_KP_Enter:
+        case ' ':
+          if (0 <= value_)
+          {
+            if (nodes_[rows_[value_]].flags & NODE_OPEN)
+            {
+              close_row(value_);
+            }
+
+            else
+            {
+              open_row(value_);
+            }
+          }
+
+          return 1;
+
+        default:
+          break;
+      }
+
+      break;
+
+    default:
+      break;
+  }
+
+  return Fl_Group::handle(event);
+}
@@ -0,0 +1,955 @@
+/*
+ vbrowser.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vbrowser.h"
+#include "fl.h"
+#include "fl_clip.h"
+#include "fl_draw.h"
+#include "fl_rend.h"
+#include "fl_utf8.h"
+
+Fl_Virtual_Browser::Fl_Virtual_Browser(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  unsigned char const* i_label) :
+  Fl_Group(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label),
+  row_cb_(0),
+  row_data_(0),
+  rows_(0),
+  multi_(false),
+  top_(0),
+  old_top_(0),
+  value_(-1),
+  anchor_(-1),
+  sel_(0),
+  nsel_(0),
+  dirty_first_(-1),
+  dirty_last_(-1),
+  find_len_(0),
+  find_time_(0),
+  find_row_(0),
+  find_left_(0),
+  row_(0),
+  row_len_(0)
+{
+
+  vscroll_ = new Fl_Scrollbar(0, 0, 1, 1);
+  vscroll_->callback((Fl_Callback*)scrollbar_cb, this);
+
+  end();
+
+  resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  return;
+}
+
+Fl_Virtual_Browser::~Fl_Virtual_Browser()
+{
+  Fl::remove_idle(idle_cb, this);
+  free(sel_);
+  free(row_);
+}
+
+void
+Fl_Virtual_Browser::rows(
+  long const i_rows)
+{
+
+  Fl::remove_idle(idle_cb, this);
+  find_left_ = 0;
+
+  rows_ = (0 > i_rows) ? 0 : i_rows;
+
+  select(rows_, LONG_MAX, false);
+
+  if (value_ >= rows_)
+  {
+    value_ = rows_ - 1;
+  }
+
+  if (anchor_ >= rows_)
+  {
+    anchor_ = value_;
+  }
+
+  if (top_ > max_top())
+  {
+    top_ = max_top();
+  }
+
+  old_top_ = top_;
+
+  redraw();
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::value(
+  long const i_row)
+{
+  long const old = value_;
+
+  value_ = (0 > i_row || i_row >= rows_) ? -1 : i_row;
+  anchor_ = value_;
+
+  if (old != value_)
+  {
+    redraw_rows(old, old);
+    redraw_rows(value_, value_);
+  }
+
+  if (0 <= value_)
+  {
+    if (false == multi_)
+    {
+      select_none();
+      select(value_, value_);
+    }
+
+    show_row(value_);
+  }
+
+  return;
+}
+
+long
+Fl_Virtual_Browser::max_top() const
+{
+  long top = rows_ - (long)text_area.h;
+
+  if (0 > top)
+  {
+    top = 0;
+  }
+
+  return top;
+}
+
+void
+Fl_Virtual_Browser::scroll_to(
+  long const i_row)
+{
+  long row = i_row;
+
+  if (row > max_top())
+  {
+    row = max_top();
+  }
+
+  if (0 > row)
+  {
+    row = 0;
+  }
+
+  if (row != top_)
+  {
+    top_ = row;
+    damage(FL_DAMAGE_SCROLL);
+  }
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::top_row(
+  long const i_row)
+{
+  scroll_to(i_row);
+}
+
+void
+Fl_Virtual_Browser::show_row(
+  long const i_row)
+{
+
+  if (i_row < top_)
+  {
+    scroll_to(i_row);
+  }
+
+  else if (i_row >= top_ + (long)text_area.h)
+  {
+    scroll_to(i_row - (long)text_area.h + 1);
+  }
+
+  return;
+}
+
+// Ranges are kept sorted, disjoint and not touching, so a row lookup
+// is a binary search.
+bool
+Fl_Virtual_Browser::selected(
+  long const i_row) const
+{
+  int lo = 0;
+  int hi = nsel_;
+
+  while (lo < hi)
+  {
+    int const mid = (lo + hi) / 2;
+
+    if (i_row < sel_[mid].first)
+    {
+      hi = mid;
+    }
+
+    else if (i_row > sel_[mid].last)
+    {
+      lo = mid + 1;
+    }
+
+    else
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void
+Fl_Virtual_Browser::select(
+  long const i_first,
+  long const i_last,
+  bool const i_on)
+{
+  long first = (i_first < i_last) ? i_first : i_last;
+  long last = (i_first < i_last) ? i_last : i_first;
+  span* ranges;
+  int count = 0;
+  int index;
+
+  if (0 > first)
+  {
+    first = 0;
+  }
+
+  // rows past the end are only ever cleared, as when rows() shrinks
+  if (i_on && last >= rows_)
+  {
+    last = rows_ - 1;
+  }
+
+  if (first > last || (false == i_on && 0 == nsel_))
+  {
+    return;
+  }
+
+  // at most one range is added, either the new one or the tail of a
+  // range split in two
+  ranges = (span*)malloc((nsel_ + 1) * sizeof(span));
+
+  if (0 == ranges)
+  {
+    return;
+  }
+
+  index = 0;
+
+  for (; nsel_ > index && sel_[index].last < first - 1; index++)
+  {
+    ranges[count++] = sel_[index];
+  }
+
+  if (i_on)
+  {
+    span merged;
+
+    merged.first = first;
+    merged.last = last;
+
+    for (; nsel_ > index && sel_[index].first <= last + 1; index++)
+    {
+      if (sel_[index].first < merged.first)
+      {
+        merged.first = sel_[index].first;
+      }
+
+      if (sel_[index].last > merged.last)
+      {
+        merged.last = sel_[index].last;
+      }
+    }
+
+    ranges[count++] = merged;
+  }
+
+  else
+  {
+    for (; nsel_ > index && sel_[index].first <= last; index++)
+    {
+      if (sel_[index].first < first)
+      {
+        ranges[count].first = sel_[index].first;
+        ranges[count].last = first - 1;
+        count++;
+      }
+
+      if (sel_[index].last > last)
+      {
+        ranges[count].first = last + 1;
+        ranges[count].last = sel_[index].last;
+        count++;
+      }
+    }
+  }
+
+  for (; nsel_ > index; index++)
+  {
+    ranges[count++] = sel_[index];
+  }
+
+  free(sel_);
+  sel_ = ranges;
+  nsel_ = count;
+
+  redraw_rows(first, last);
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::select_none()
+{
+  int index;
+
+  for (index = 0; nsel_ > index; index++)
+  {
+    redraw_rows(sel_[index].first, sel_[index].last);
+  }
+
+  nsel_ = 0;
+
+  return;
+}
+
+bool
+Fl_Virtual_Browser::range(
+  int const i_index,
+  long* o_first,
+  long* o_last) const
+{
+
+  if (0 > i_index || i_index >= nsel_)
+  {
+    return false;
+  }
+
+  *o_first = sel_[i_index].first;
+  *o_last = sel_[i_index].last;
+
+  return true;
+}
+
+// Marks rows for the next draw. Only rows on screen are kept; a
+// selection spanning a million rows still costs one screen of redraw.
+void
+Fl_Virtual_Browser::redraw_rows(
+  long const i_first,
+  long const i_last)
+{
+  long first = (top_ > i_first) ? top_ : i_first;
+  long last = top_ + (long)text_area.h - 1;
+
+  if (i_last < last)
+  {
+    last = i_last;
+  }
+
+  if (0 > first || first > last)
+  {
+    return;
+  }
+
+  if (0 > dirty_first_ || first < dirty_first_)
+  {
+    dirty_first_ = first;
+  }
+
+  if (last > dirty_last_)
+  {
+    dirty_last_ = last;
+  }
+
+  damage(FL_DAMAGE_USER1);
+
+  return;
+}
+
+// Moves the current row, either selecting it alone or, with i_extend,
+// selecting everything between it and the anchor.
+void
+Fl_Virtual_Browser::move_to(
+  long const i_row,
+  bool const i_extend)
+{
+  long const old = value_;
+  long row = i_row;
+
+  if (0 == rows_)
+  {
+    return;
+  }
+
+  if (0 > row)
+  {
+    row = 0;
+  }
+
+  if (row >= rows_)
+  {
+    row = rows_ - 1;
+  }
+
+  if (i_extend && multi_ && 0 <= anchor_)
+  {
+    select_none();
+    select(anchor_, row);
+  }
+
+  else
+  {
+    select_none();
+    select(row, row);
+    anchor_ = row;
+  }
+
+  value_ = row;
+
+  redraw_rows(old, old);
+  redraw_rows(row, row);
+  show_row(row);
+
+  do_callback();
+
+  return;
+}
+
+unsigned int
+Fl_Virtual_Browser::fetch(
+  long const i_row)
+{
+  unsigned int len = 0;
+
+  if (row_cb_ && row_)
+  {
+    len = (*row_cb_)(i_row, row_, row_len_, row_data_);
+
+    if (len > row_len_)
+    {
+      len = row_len_;
+    }
+  }
+
+  if (row_)
+  {
+    row_[len] = 0;
+  }
+
+  return len;
+}
+
+// Appends to the type-ahead prefix, which is forgotten after a second
+// without typing. A longer prefix may still match the current row, a
+// new one starts below it.
+void
+Fl_Virtual_Browser::find(
+  unsigned char const* i_text,
+  unsigned int const i_len)
+{
+  time_t const now = time(0);
+  unsigned int len = i_len;
+
+  if (1 < now - find_time_)
+  {
+    find_len_ = 0;
+  }
+
+  find_time_ = now;
+
+  if (len > FIND_MAX - find_len_)
+  {
+    len = FIND_MAX - find_len_;
+  }
+
+  memcpy(find_ + find_len_, i_text, len);
+  find_len_ += len;
+  find_[find_len_] = 0;
+
+  if (0 == rows_ || 0 == find_len_)
+  {
+    return;
+  }
+
+  find_row_ = (0 > value_) ? 0 : value_;
+
+  if (find_len_ == len)
+  {
+    find_row_ = (find_row_ + 1) % rows_;
+  }
+
+  find_left_ = rows_;
+
+  find_slice();
+
+  if (find_left_ && 0 == Fl::has_idle(idle_cb, this))
+  {
+    Fl::add_idle(idle_cb, this);
+  }
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::find_slice()
+{
+  int const chars = fl_utf_nb_char(find_, (int)find_len_);
+  long budget = SLICE;
+
+  while (budget && find_left_)
+  {
+    fetch(find_row_);
+
+    if (row_ && 0 == fl_utf_strncasecmp((char const*)row_,
+                                        (char const*)find_, chars))
+    {
+      find_left_ = 0;
+      move_to(find_row_, false);
+      break;
+    }
+
+    find_row_ = (find_row_ + 1) % rows_;
+    find_left_--;
+    budget--;
+  }
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::idle_cb(
+  void* i_data)
+{
+  Fl_Virtual_Browser* browser = (Fl_Virtual_Browser*)i_data;
+
+  browser->find_slice();
+
+  if (0 == browser->find_left_)
+  {
+    Fl::remove_idle(idle_cb, browser);
+  }
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::update_scrollbar()
+{
+  long total = rows_;
+  long top = top_;
+
+  if (INT_MAX < total)
+  {
+    total = INT_MAX;
+  }
+
+  if (INT_MAX < top)
+  {
+    top = INT_MAX;
+  }
+
+  vscroll_->value((int)top, (int)text_area.h, 0, (int)total);
+  vscroll_->linesize(1);
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::scrollbar_cb(
+  Fl_Scrollbar* i_bar,
+  Fl_Virtual_Browser* i_browser)
+{
+  i_browser->scroll_to(i_bar->value());
+}
+
+void
+Fl_Virtual_Browser::resize(
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y)
+{
+  unsigned int len;
+
+  Fl_Widget::resize(i_pos_x, i_pos_y, i_len_x, i_len_y);
+
+  text_area.x = i_pos_x;
+  text_area.y = i_pos_y;
+  text_area.w = (i_len_x > 1) ? i_len_x - 1 : 0;
+  text_area.h = i_len_y;
+
+  vscroll_->resize(i_pos_x + text_area.w, i_pos_y, 1, text_area.h);
+
+  // wide enough for a row and for a type-ahead prefix
+  len = (FIND_MAX > text_area.w) ? FIND_MAX : text_area.w;
+
+  if (row_len_ < len)
+  {
+    unsigned char* row = (unsigned char*)realloc(row_, len + 1);
+
+    if (row)
+    {
+      row_ = row;
+      row_len_ = len;
+    }
+  }
+
+  if (top_ > max_top())
+  {
+    top_ = max_top();
+  }
+
+  old_top_ = top_;
+
+  return;
+}
+
+// Control characters are shown as '.' and the row is cut and padded to
+// the width of the text area in cells, on a UTF-8 character boundary.
+void
+Fl_Virtual_Browser::draw_row(
+  long const i_row)
+{
+  int const ypos = text_area.y + (int)(i_row - top_);
+  unsigned int const cols = (row_len_ < text_area.w) ? row_len_ : text_area.w;
+  enum Fl::foreground fcolor = skin_->normal_fcolor;
+  enum Fl::background bcolor = skin_->normal_bcolor;
+  unsigned int len;
+  unsigned int col;
+  unsigned int width;
+  int clen;
+  int cwidth;
+
+  if (i_row < top_ || i_row >= top_ + (long)text_area.h)
+  {
+    return;
+  }
+
+  if (i_row >= rows_ || 0 == row_)
+  {
+    Fl::draw_fill(text_area.x, ypos, text_area.w, 1, 0x20, fcolor, bcolor);
+    return;
+  }
+
+  if (false == active_r())
+  {
+    fcolor = skin_->disabled_fcolor;
+  }
+
+  else if (selected(i_row))
+  {
+    fcolor = skin_->highlight_fcolor;
+  }
+
+  if (i_row == value_ && Fl::focus() == this)
+  {
+    bcolor = skin_->focused_bcolor;
+
+    if (false == selected(i_row))
+    {
+      fcolor = skin_->focused_fcolor;
+    }
+  }
+
+  len = fetch(i_row);
+  width = 0;
+
+  for (col = 0; len > col; col += clen)
+  {
+    if (0x20 > row_[col] || 0x7f == row_[col])
+    {
+      row_[col] = '.';
+    }
+
+    cwidth = fl_wcwidth_(fl_utf8decode((char const*)row_ + col,
+                                       (char const*)row_ + len, &clen));
+
+    if (0 > cwidth)
+    {
+      cwidth = 1;
+    }
+
+    if (width + cwidth > cols)
+    {
+      break;
+    }
+
+    width += cwidth;
+  }
+
+  Fl::draw_puts(text_area.x, ypos, row_, col, fcolor, bcolor);
+
+  if (cols > width)
+  {
+    Fl::draw_fill(text_area.x + width, ypos, cols - width, 1, 0x20, fcolor, bcolor);
+  }
+
+  return;
+}
+
+void
+Fl_Virtual_Browser::draw_area(
+  void* i_data,
+  int const i_pos_x,
+  int const i_pos_y,
+  unsigned int const i_len_x,
+  unsigned int const i_len_y,
+  enum Fl::foreground const i_fcolor,
+  enum Fl::background const i_bcolor)
+{
+  Fl_Virtual_Browser* browser = (Fl_Virtual_Browser*)i_data;
+  long row = browser->top_ + (long)(i_pos_y - browser->text_area.y);
+  long const end = row + (long)i_len_y;
+
+  for (; end > row; row++)
+  {
+    browser->draw_row(row);
+  }
+
+  return;
+}
+
+// A scroll moves the rows still on screen and fetches only those that
+// came into view; other changes redraw the rows marked by redraw_rows.
+// The damage is read first: moving the scrollbar damages this group too.
+void
+Fl_Virtual_Browser::draw()
+{
+  unsigned char const d = damage();
+  long row;
+
+  Fl::clip_push(x(), y(), w(), h());
+
+  update_scrollbar();
+
+  if (d & (FL_DAMAGE_ALL | FL_DAMAGE_CHILD))
+  {
+    vscroll_->damage(FL_DAMAGE_ALL);
+  }
+
+  update_child(*vscroll_);
+
+  Fl::clip_push(text_area.x, text_area.y, text_area.w, text_area.h);
+
+  if (d & (FL_DAMAGE_ALL | FL_DAMAGE_EXPOSE))
+  {
+    draw_area(this, text_area.x, text_area.y, text_area.w, text_area.h,
+              skin_->normal_fcolor, skin_->normal_bcolor);
+  }
+
+  else
+  {
+    if ((d & FL_DAMAGE_SCROLL) && old_top_ != top_)
+    {
+      long delta = old_top_ - top_;
+
+      // a jump of a screen or more redraws everything anyway
+      if (delta > (long)text_area.h)
+      {
+        delta = (long)text_area.h;
+      }
+
+      else if (-(long)text_area.h > delta)
+      {
+        delta = -(long)text_area.h;
+      }
+
+      fl_scroll(text_area.x, text_area.y, text_area.w, text_area.h, 0,
+                (int)delta, draw_area, this, *skin_);
+    }
+
+    if ((d & FL_DAMAGE_USER1) && 0 <= dirty_first_)
+    {
+      for (row = dirty_first_; dirty_last_ >= row; row++)
+      {
+        draw_row(row);
+      }
+    }
+  }
+
+  Fl::clip_pop();
+  Fl::clip_pop();
+
+  old_top_ = top_;
+  dirty_first_ = -1;
+  dirty_last_ = -1;
+
+  return;
+}
+
+bool
+Fl_Virtual_Browser::handle(
+  enum Fl_Event const event)
+{
+  long const page = (1 < text_area.h) ? (long)text_area.h - 1 : 1;
+  bool const extend = (0 != Fl::event_state(FL_SHIFT));
+  long row;
+
+  switch (event)
+  {
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+      redraw_rows(value_, value_);
+      return 1;
+
+    case FL_PUSH:
+      if (false == Fl::event_inside(text_area.x, text_area.y, text_area.w,
+                                    text_area.h))
+      {
+        return Fl_Group::handle(event);
+      }
+
+      if (Fl::focus() != this)
+      {
+        Fl::focus(this);
+        handle(FL_FOCUS);
+      }
+
+      row = top_ + (long)(Fl::event_y() - text_area.y);
+
+      if (row >= rows_)
+      {
+        return 1;
+      }
+
+      if (multi_ && Fl::event_state(FL_CTRL))
+      {
+        long const old = value_;
+
+        select(row, row, false == selected(row));
+        value_ = row;
+        anchor_ = row;
+        redraw_rows(old, old);
+        redraw_rows(row, row);
+        do_callback();
+      }
+
+      else
+      {
+        move_to(row, extend);
+      }
+
+      return 1;
+
+    case FL_DRAG:
+      if (Fl::pushed() != this || 0 == rows_)
+      {
+        break;
+      }
+
+      row = top_ + (long)(Fl::event_y() - text_area.y);
+
+      if (row >= rows_)
+      {
+        row = rows_ - 1;
+      }
+
+      if (row != value_)
+      {
+        move_to(row, true);
+      }
+
+      return 1;
+
+    case FL_RELEASE:
+      if (Fl::pushed() != this)
+      {
+        break;
+      }
+
+      return 1;
+
+    case FL_MOUSEWHEEL:
+      return vscroll_->handle(event);
+
+    case FL_KEYBOARD:
+      switch (Fl::event_key())
+      {
+        case FL_Up:
+          move_to(value_ - 1, extend);
+          return 1;
+
+        case FL_Down:
+          move_to(value_ + 1, extend);
+          return 1;
+
+        case FL_Page_Up:
+          move_to(value_ - page, extend);
+          return 1;
+
+        case FL_Page_Down:
+          move_to(value_ + page, extend);
+          return 1;
+
+        case FL_Home:
+          move_to(0, extend);
+          return 1;
+
+        case FL_End:
+          move_to(LONG_MAX, extend);
+          return 1;
+
+        case FL_Enter:
+        case FL_KP_Enter:
+          do_callback();
+          return 1;
+
+        case ' ':
+          if (multi_ && 0 <= value_ && 1 < time(0) - find_time_)
+          {
+            select(value_, value_, false == selected(value_));
+            anchor_ = value_;
+            do_callback();
+            return 1;
+          }
+
+          break;
+
+        default:
+          break;
+      }
+
+      if (multi_ && Fl::event_state(FL_CTRL) && 'a' == Fl::event_key())
+      {
+        select(0, LONG_MAX);
+        do_callback();
+        return 1;
+      }
+
+      if (Fl::event_length() && 0x20 <= Fl::event_text()[0] &&
+          0 == Fl::event_state(FL_CTRL | FL_ALT))
+      {
+        find(Fl::event_text(), (unsigned int)Fl::event_length());
+        return 1;
+      }
+
+      break;
+
+    default:
+      break;
+  }
+
+  return Fl_Group::handle(event);
+}
@@ -70,6 +70,7 @@
 #include "widget.h"
 #include "fl.h"
 #include "fl_draw.h"
+#include "fl_rend.h"
 #include "flstring.h"
 #include "group.h"
 #include "win.h"
@@ -149,7 +150,7 @@ Fl_Widget::Fl_Widget(
   unsigned char const* i_label)
 {
 
-  skin_ = Fl::_skin_widget;
+  skin_ = &Fl::_skin_widget;
 
   x_ = i_pos_x;
   y_ = i_pos_y;
@@ -159,6 +160,7 @@ Fl_Widget::Fl_Widget(
   label_.value   = i_label;
   label_.type  = Fl_Label::FL_NORMAL_LABEL;
   label_.align_  = Fl_Label::FL_ALIGN_CENTER;
+  layout_ = 0;
   callback_  = default_callback;
   user_data_   = 0;
   type_    = 0;
@@ -185,6 +187,18 @@ Fl_Widget::resize(
   y_ = y;
   w_ = w;
   h_ = h;
+  fl_layout_clear(layout_);
+
+  if (parent_) parent_->hit_clear();
+}
+
+void
+Fl_Widget::align(enum Fl_Label::Fl_Align const alignment)
+{
+  label_.align_ = alignment;
+  fl_layout_clear(layout_);
+
+  if (parent_) parent_->hit_clear();
 }
 
 int
@@ -222,9 +236,12 @@ extern void fl_throw_focus(Fl_Widget*);
 Fl_Widget::~Fl_Widget()
 {
   Fl::clear_widget_pointer(this);
+  Fl::remove_shortcut(this);
 
   if (flags() & COPIED_LABEL) free((void*)(label_.value));
 
+  fl_layout_free(layout_);
+
   if (parent_) parent_->remove(this);
 
   parent_ = 0;
@@ -351,9 +368,20 @@ Fl_Widget::label(const unsigned char* a)
   }
 
   label_.value = a;
+  fl_layout_clear(layout_);
+  update_label_shortcut();
   redraw_label();
 }
 
+void
+Fl_Widget::label(Fl_Label::Fl_LabelType const a, const unsigned char* b)
+{
+  label_.type = a;
+  label_.value = b;
+  fl_layout_clear(layout_);
+  update_label_shortcut();
+}
+
 
 void
 Fl_Widget::copy_label(const unsigned char* a)
@@ -391,7 +419,7 @@ void
 Fl_Widget::draw_box() const
 {
 
-  draw_box(x_, y_, w_, h_, skin_.box_fcolor, skin_.box_bcolor);
+  draw_box(x_, y_, w_, h_, skin_->box_fcolor, skin_->box_bcolor);
 
   return;
 }
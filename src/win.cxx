@@ -99,7 +99,7 @@ Fl_Window::Fl_Window(
   unsigned char const* i_label) :
   Fl_Group(i_pos_x, i_pos_y, i_len_x, i_len_y, i_label),
   pWindowDriver(Fl_Window_Driver::newWindowDriver(this)),
-  skin_(Fl::_skin_win)
+  skin_(&Fl::_skin_win)
 {
   _Fl_Window();
   set_flag(FORCE_POSITION);
@@ -253,9 +253,9 @@ Fl_Window::draw()
   if (damage() & ~FL_DAMAGE_CHILD)
   {
     Fl::draw_fill(0, 0, w_, h_,
-                  skin_.fillc, skin_.fill_fcolor, skin_.fill_bcolor);
+                  skin_->fillc, skin_->fill_fcolor, skin_->fill_bcolor);
     draw_box(0, 0, w_, h_,
-             Fl_Widget::skin_.box_fcolor, Fl_Widget::skin_.box_bcolor);
+             Fl_Widget::skin_->box_fcolor, Fl_Widget::skin_->box_bcolor);
   }
 
   draw_children();
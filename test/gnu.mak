@@ -12,6 +12,10 @@ INCLUDES=-I../include
 
 DEFINES=-D__CURSES__
 
+ifdef NCURSESW
+DEFINES+=-D__NCURSESW__
+endif
+
 LIB=../lib
 
 FLTKLIB=$(LIB)/fltkcon.a
@@ -27,15 +31,24 @@ CXXFLAGS=\
 EXES=\
     talign\
     tbutton\
+    tfilevw\
     thello\
     tinpfile\
     tinput\
     tmenubar\
     tscroll\
+    tform\
+    ttable\
     ttexted\
-    tvaluato
+    ttree\
+    tvaluato\
+    tvbrows
 
+ifdef NCURSESW
+LIBS=-L ../lib $(FLTKLIB) -l ncursesw
+else
 LIBS=-L ../lib $(FLTKLIB) -l curses
+endif
 
 .PHONY : all
 all : $(EXES)
@@ -46,6 +59,9 @@ talign : talign.o
 tbutton : tbutton.o
 	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
 
+tfilevw : tfilevw.o
+	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
+
 thello : thello.o
 	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
 
@@ -61,12 +77,24 @@ tmenubar : tmenubar.o
 tscroll : tscroll.o
 	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
 
+tform : tform.o
+	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
+
+ttable : ttable.o
+	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
+
 ttexted : ttexted.o
 	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
 
+ttree : ttree.o
+	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
+
 tvaluato : tvaluato.o
 	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
 
+tvbrows : tvbrows.o
+	$(CXX) $(CXXFLAGS) -o $@ $? $(LIBS)
+
 %.o : %.cxx
 	${CXX} -c ${CXXFLAGS} -o $@ $<
 
@@ -27,12 +27,17 @@ FLTKLIB=$(LIB)\fltkpm.lib
 
 EXES= &
     talign.exe &
+    tfilevw.exe &
     tinpfile.exe &
     tinput.exe &
     tmenubar.exe &
     tscroll.exe &
+    tform.exe &
+    ttable.exe &
     ttexted.exe &
-    tvaluato.exe
+    ttree.exe &
+    tvaluato.exe &
+    tvbrows.exe
 
 all : $(EXES) .SYMBOLIC    
 
@@ -42,6 +47,9 @@ all : $(EXES) .SYMBOLIC
 talign.exe : talign.obj
 	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
 
+tfilevw.exe : tfilevw.obj
+	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
+
 tinpfile.exe : tinpfile.obj
 	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
 
@@ -54,12 +62,24 @@ tmenubar.exe : tmenubar.obj
 tscroll.exe : tscroll.obj
 	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
 
+tform.exe : tform.obj
+	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
+
+ttable.exe : ttable.obj
+	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
+
 ttexted.exe : ttexted.obj
 	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
 
+ttree.exe : ttree.obj
+	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
+
 tvaluato.exe : tvaluato.obj
 	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
 
+tvbrows.exe : tvbrows.obj
+	*wlink NAME $^@ DEBUG ALL SYSTEM $(SYSTEM) FILE $<, $(FLTKLIB)
+
 clean : .SYMBOLIC
 	@rm *.obj
 	@rm *.exe
@@ -0,0 +1,51 @@
+/*
+ tfilevw.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <stdio.h>
+#include "win.h"
+#include "input.h"
+#include "fileview.h"
+
+static void
+search_cb(Fl_Widget* widget, void* userdata)
+{
+  Fl_Input* input = reinterpret_cast<Fl_Input*>(widget);
+  Fl_File_View* view = reinterpret_cast<Fl_File_View*>(userdata);
+  view->search(input->value());
+  return;
+}
+
+int
+main(int argc, char** argv)
+{
+
+  if (2 > argc)
+  {
+    fprintf(stderr, "usage: %s file\n", argv[0]);
+    return 1;
+  }
+
+  Fl_Window w(1, 1, 78, 23, (unsigned char*)"File View");
+  Fl_Input input(8, 0, 40, 1, (unsigned char*)"Find:");
+  Fl_File_View view(0, 2, 76, 19);
+  w.end();
+
+  if (view.load(argv[1]))
+  {
+    perror(argv[1]);
+    return 1;
+  }
+
+  input.when(Fl_Widget::FL_WHEN_ENTER_KEY_ALWAYS);
+  input.callback(search_cb, &view);
+
+  w.show();
+  Fl::run();
+  return 0;
+}
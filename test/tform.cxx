@@ -0,0 +1,122 @@
+/*
+ tform.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <stdio.h>
+#if defined(__WATCOMC__) || defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "win.h"
+#include "scroll.h"
+#include "btn.h"
+#include "box.h"
+
+enum
+{
+  FORM_ROWS = 10000,
+  FORM_COLS = 5,
+  FORM_WIDGETS = (FORM_ROWS * FORM_COLS)
+};
+
+// bytes in use on the heap, or 0 where the runtime does not tell
+static unsigned long
+heap_used()
+{
+  unsigned long used = 0;
+#if defined(__WATCOMC__)
+  struct _heapinfo info;
+
+  info._pentry = 0;
+
+  while (_HEAPOK == _heapwalk(&info))
+  {
+    if (_USEDENTRY == info._useflag)
+    {
+      used += info._size;
+    }
+  }
+
+#elif defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+  struct mallinfo2 info = mallinfo2();
+#else
+  struct mallinfo info = mallinfo();
+#endif
+
+  used = (unsigned long)(info.uordblks + info.hblkhd);
+#endif
+  return used;
+}
+
+static void
+theme_cb(Fl_Widget* widget, void* userdata)
+{
+  Fl_Window* window = reinterpret_cast<Fl_Window*>(userdata);
+
+  // every button follows the change, the customized rows as well
+  if (Fl::fcolor_blue == Fl::_skin_widget.focused_fcolor)
+  {
+    Fl::_skin_widget.focused_fcolor = Fl::fcolor_red;
+  }
+
+  else
+  {
+    Fl::_skin_widget.focused_fcolor = Fl::fcolor_blue;
+  }
+
+  Fl::skin_changed();
+  window->redraw();
+
+  return;
+}
+
+int
+main(int argc, char** argv)
+{
+  static char text[80];
+  struct Fl::skin_widget skin = Fl::_skin_widget;
+  unsigned long heap;
+  int row;
+  int col;
+
+  Fl_Window window(1, 1, 60, 20, (unsigned char*)"Form");
+  Fl_Scroll flscroll(0, 0, 58, 17);
+
+  // odd rows share one customized skin
+  skin.normal_bcolor = Fl::bcolor_blue;
+  heap = heap_used();
+
+  for (row = 0; FORM_ROWS > row; row++)
+  {
+    for (col = 0; FORM_COLS > col; col++)
+    {
+      Fl_Button* button = new Fl_Button((col * 11), row, 10, 1,
+                                        (unsigned char*)"field");
+
+      if (row & 1)
+      {
+        button->skin_ = Fl::skin_intern(skin);
+      }
+    }
+  }
+
+  flscroll.end();
+
+  // what building the form took from the heap
+  heap = heap_used() - heap;
+  sprintf(text, "%d widgets, %lu KB heap, %lu bytes each",
+          FORM_WIDGETS, heap / 1024, heap / FORM_WIDGETS);
+  Fl_Box status(0, 18, 44, 1, (unsigned char*)text);
+  Fl_Button theme(46, 18, 12, 1, (unsigned char*)"theme");
+  theme.callback(theme_cb, &window);
+
+  window.end();
+  window.show(argc, argv);
+
+  return Fl::run();
+}
@@ -187,10 +187,12 @@ main(int argc, char** argv)
       sprintf((char*)buf, "%d", n++);
       Fl_Button* b = new Fl_Button((x - 1) * 12, y, 10, 1);
       b->copy_label(buf);
-      b->skin_.normal_fcolor = Fl::fcolor_white;
-      b->skin_.normal_bcolor = bgcolor[x];
-      b->skin_.focused_fcolor = Fl::fcolor_black;
-      b->skin_.focused_bcolor = Fl::bcolor_light_gray;
+      struct Fl::skin_widget skin = *b->skin_;
+      skin.normal_fcolor = Fl::fcolor_white;
+      skin.normal_bcolor = bgcolor[x];
+      skin.focused_fcolor = Fl::fcolor_black;
+      skin.focused_bcolor = Fl::bcolor_light_gray;
+      b->skin_ = Fl::skin_intern(skin);
     }
 
   Drawing drawing(1, y, 34, 5, 0);
@@ -201,10 +203,12 @@ main(int argc, char** argv)
       sprintf((char*)buf, "%d", n++);
       Fl_Button* b = new Fl_Button((x - 1) * 12, y, 10, 1);
       b->copy_label(buf);
-      b->skin_.normal_fcolor = Fl::fcolor_white;
-      b->skin_.normal_bcolor = bgcolor[x];
-      b->skin_.focused_fcolor = Fl::fcolor_black;
-      b->skin_.focused_bcolor = Fl::bcolor_light_gray;
+      struct Fl::skin_widget skin = *b->skin_;
+      skin.normal_fcolor = Fl::fcolor_white;
+      skin.normal_bcolor = bgcolor[x];
+      skin.focused_fcolor = Fl::fcolor_black;
+      skin.focused_bcolor = Fl::bcolor_light_gray;
+      b->skin_ = Fl::skin_intern(skin);
     }
 
   flscroll.end();
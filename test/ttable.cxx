@@ -0,0 +1,129 @@
+/*
+ ttable.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "win.h"
+#include "fl_draw.h"
+#include "table.h"
+
+enum
+{
+  TABLE_ROWS = 100000,
+  TABLE_COLS = 12
+};
+
+static int ticks[TABLE_ROWS];
+
+class Quotes : public Fl_Table
+{
+
+  public:
+
+    Quotes(
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y) :
+      Fl_Table(i_pos_x, i_pos_y, i_len_x, i_len_y)
+    {
+    }
+
+  protected:
+
+    virtual void
+    draw_cell(
+      long const i_row,
+      int const i_col,
+      int const i_pos_x,
+      int const i_pos_y,
+      unsigned int const i_len_x,
+      unsigned int const i_len_y)
+    {
+      char text[32];
+      enum Fl::foreground fcolor = skin_->normal_fcolor;
+      enum Fl::background bcolor = skin_->normal_bcolor;
+
+      if (0 > i_row && 0 > i_col)
+      {
+        text[0] = 0;
+      }
+
+      else if (0 > i_row)
+      {
+        sprintf(text, " col %d", i_col);
+      }
+
+      else if (0 > i_col)
+      {
+        sprintf(text, "%6ld", i_row);
+      }
+
+      else
+      {
+        sprintf(text, "%7d", ticks[i_row] * (i_col + 1));
+      }
+
+      if (0 > i_row || 0 > i_col)
+      {
+        fcolor = skin_->box_fcolor;
+        bcolor = skin_->box_bcolor;
+      }
+
+      Fl::draw_fill(i_pos_x, i_pos_y, i_len_x, i_len_y, 0x20, fcolor, bcolor);
+      Fl::draw_puts(i_pos_x, i_pos_y, (unsigned char*)text,
+                    (unsigned int)strlen(text), fcolor, bcolor);
+
+      return;
+    }
+
+};
+
+static void
+tick_cb(void* userdata)
+{
+  Quotes* table = reinterpret_cast<Quotes*>(userdata);
+  int i;
+
+  for (i = 0; 20 > i; i++)
+  {
+    long row = table->top_row() + (rand() % 20);
+
+    if (row < TABLE_ROWS)
+    {
+      ticks[row]++;
+      table->redraw_range(row, row, 0, TABLE_COLS - 1);
+    }
+  }
+
+  Fl::repeat_timeout(0.1, tick_cb, userdata);
+
+  return;
+}
+
+int
+main(int argc, char** argv)
+{
+  Fl_Window w(1, 1, 78, 23, (unsigned char*)"Table");
+  Quotes table(0, 0, 76, 21);
+  w.end();
+
+  table.rows(TABLE_ROWS);
+  table.cols(TABLE_COLS);
+  table.col_width_all(9);
+  table.row_header(true);
+  table.col_header(true);
+
+  Fl::add_timeout(0.1, tick_cb, &table);
+
+  w.show();
+  Fl::run();
+  return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ ttree.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <stdio.h>
+#include "win.h"
+#include "box.h"
+#include "tree.h"
+
+static void
+populate_cb(Fl_Tree* tree, int const node, void* userdata)
+{
+  char text[64];
+  int i;
+
+  // every branch holds 1000 entries, one in ten of them a branch again
+  for (i = 0; 1000 > i; i++)
+  {
+    sprintf(text, "%s.%d", (char const*)tree->label(node), i);
+    tree->add(node, (unsigned char*)text, (0 == (i % 10)));
+  }
+
+  return;
+}
+
+static void
+tree_cb(Fl_Widget* widget, void* userdata)
+{
+  Fl_Tree* tree = reinterpret_cast<Fl_Tree*>(widget);
+  Fl_Box* status = reinterpret_cast<Fl_Box*>(userdata);
+  static char text[80];
+
+  sprintf(text, "%d nodes, %d rows", tree->nodes(), tree->visible_rows());
+  status->label((unsigned char*)text);
+
+  return;
+}
+
+int
+main(int argc, char** argv)
+{
+  Fl_Window w(1, 1, 78, 23, (unsigned char*)"Tree");
+  Fl_Tree tree(0, 0, 76, 19);
+  Fl_Box status(0, 20, 76, 1);
+  w.end();
+
+  tree.populate_callback(populate_cb);
+  tree.add(-1, (unsigned char*)"root", true);
+  tree.callback(tree_cb, &status);
+
+  w.show();
+  Fl::run();
+  return 0;
+}
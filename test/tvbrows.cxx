@@ -0,0 +1,75 @@
+/*
+ tvbrows.cxx
+
+ License CC0 PUBLIC DOMAIN
+
+ To the extent possible under law, Mark J. Olesen has waived all copyright
+ and related or neighboring rights to fltkcon Library. This work is published
+ from: United States.
+*/
+#include <stdio.h>
+#include <string.h>
+#include "win.h"
+#include "box.h"
+#include "vbrowser.h"
+
+static char const* words[] =
+{
+  "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf",
+  "hotel", "india", "juliett", "kilo", "lima", "mike", "november"
+};
+
+static unsigned int
+row_cb(
+  long const i_row,
+  unsigned char* o_text,
+  unsigned int const i_size,
+  void* i_data)
+{
+  char buf[64];
+  int len;
+
+  len = sprintf(buf, "%s %07ld", words[i_row % (sizeof(words) / sizeof(*words))],
+                i_row);
+
+  if ((unsigned int)len > i_size)
+  {
+    len = (int)i_size;
+  }
+
+  memcpy(o_text, buf, (size_t)len);
+
+  return (unsigned int)len;
+}
+
+static void
+browser_cb(Fl_Widget* widget, void* userdata)
+{
+  Fl_Virtual_Browser* browser = reinterpret_cast<Fl_Virtual_Browser*>(widget);
+  Fl_Box* status = reinterpret_cast<Fl_Box*>(userdata);
+  static char text[80];
+
+  sprintf(text, "row %ld, %d range(s) selected", browser->value(),
+          browser->ranges());
+  status->label((unsigned char*)text);
+
+  return;
+}
+
+int
+main(int argc, char** argv)
+{
+  Fl_Window w(1, 1, 78, 23, (unsigned char*)"Virtual Browser");
+  Fl_Virtual_Browser browser(0, 0, 76, 19);
+  Fl_Box status(0, 20, 76, 1);
+  w.end();
+
+  browser.row_callback(row_cb);
+  browser.rows(1000000L);
+  browser.multi(true);
+  browser.callback(browser_cb, &status);
+
+  w.show();
+  Fl::run();
+  return 0;
+}